@@ -0,0 +1,83 @@
+//
+// Created by glom on 11/4/25.
+//
+// Compares the dispatched limb kernels against the portable reference implementations.
+// Usage: limb_kernels_bench [limbs] [iterations]
+//
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "limb_kernels.h"
+
+using Kernel = uint64_t (*)(uint64_t*, const uint64_t*, size_t, uint64_t);
+using SpanKernel = uint64_t (*)(uint64_t*, const uint64_t*, const uint64_t*, size_t);
+
+// Schoolbook product of two n-limb numbers, one kernel call per row
+double time_mul_rows(const Kernel kernel, const std::vector<uint64_t>& a, const std::vector<uint64_t>& b,
+                     const size_t iterations, uint64_t& checksum)
+{
+    std::vector<uint64_t> result(a.size() + b.size());
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t it = 0; it < iterations; ++it)
+    {
+        std::fill(result.begin(), result.end(), 0);
+        for (size_t i = 0; i < b.size(); ++i)
+        {
+            result[i + a.size()] = kernel(result.data() + i, a.data(), a.size(), b[i]);
+        }
+        checksum += result[it % result.size()];
+    }
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / static_cast<double>(iterations);
+}
+
+double time_span(const SpanKernel kernel, const std::vector<uint64_t>& a, const std::vector<uint64_t>& b,
+                 const size_t iterations, uint64_t& checksum)
+{
+    std::vector<uint64_t> result(a.size());
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t it = 0; it < iterations; ++it)
+    {
+        checksum += kernel(result.data(), a.data(), b.data(), a.size());
+        checksum += result[it % result.size()];
+    }
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / static_cast<double>(iterations);
+}
+
+int main(const int argc, char** argv)
+{
+    const size_t limbs = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 64;
+    const size_t iterations = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 20000;
+
+    std::mt19937_64 rng(42);
+    std::vector<uint64_t> a(limbs);
+    std::vector<uint64_t> b(limbs);
+    for (size_t i = 0; i < limbs; ++i)
+    {
+        a[i] = rng();
+        b[i] = rng();
+    }
+
+    uint64_t checksum = 0;
+    std::printf("limbs: %zu, iterations: %zu, bmi2+adx: %s\n", limbs, iterations,
+                limb_kernels::has_adx() ? "yes" : "no");
+    std::printf("%-12s %14s %14s\n", "kernel", "portable ns", "dispatched ns");
+    std::printf("%-12s %14.1f %14.1f\n", "add_n",
+                time_span(limb_kernels::portable::add_n, a, b, iterations * limbs, checksum),
+                time_span(limb_kernels::add_n, a, b, iterations * limbs, checksum));
+    std::printf("%-12s %14.1f %14.1f\n", "sub_n",
+                time_span(limb_kernels::portable::sub_n, a, b, iterations * limbs, checksum),
+                time_span(limb_kernels::sub_n, a, b, iterations * limbs, checksum));
+    std::printf("%-12s %14.1f %14.1f\n", "addmul rows",
+                time_mul_rows(limb_kernels::portable::addmul_1, a, b, iterations, checksum),
+                time_mul_rows(limb_kernels::addmul_1, a, b, iterations, checksum));
+    std::printf("%-12s %14.1f %14.1f\n", "submul rows",
+                time_mul_rows(limb_kernels::portable::submul_1, a, b, iterations, checksum),
+                time_mul_rows(limb_kernels::submul_1, a, b, iterations, checksum));
+    std::printf("checksum: %llu\n", static_cast<unsigned long long>(checksum));
+    return 0;
+}
@@ -0,0 +1,60 @@
+//
+// Created by glom on 11/2/25.
+//
+
+#ifndef GLOM_ACCUMULATOR_H
+#define GLOM_ACCUMULATOR_H
+#include <compare>
+
+#include "expr.h"
+
+/**
+ * A running result of a variadic arithmetic primitive, held natively instead of as a chain
+ * of boxed intermediate Exprs.
+ *
+ * The accumulator only ever climbs the numeric tower:
+ * - Fixnum: an unboxed int64, stepped with the overflow builtins.
+ * - Integer: an exact integer once a fixnum step overflows.
+ * - Rational: an unreduced rational, normalized when boxed (or when it grows too large).
+ * - Real: an inexact number once any operand is inexact.
+ *
+ * Only box() allocates an Expr.
+ */
+class NumberAccumulator
+{
+public:
+    enum class Rank
+    {
+        FIXNUM,
+        INTEGER,
+        RATIONAL,
+        REAL,
+    };
+
+private:
+    Rank rank;
+    int64_t fixnum = 0;
+    integer exact_int;
+    rational exact_rat;
+    real inexact = 0;
+
+    void promote(Rank target);
+
+public:
+    explicit NumberAccumulator(const Expr& number);
+
+    static Rank rank_of(const Expr& number);
+
+    void add(const Expr& number);
+    void sub(const Expr& number);
+    void mul(const Expr& number);
+    void negate();
+
+    [[nodiscard]] Rank get_rank() const;
+    [[nodiscard]] shared_ptr<Expr> box();
+};
+
+// Three-way comparison of two numbers without boxing a coerced operand; unordered if a NaN is involved
+std::partial_ordering compare_numbers(const Expr& a, const Expr& b);
+
+#endif //GLOM_ACCUMULATOR_H
@@ -5,6 +5,7 @@
 #ifndef GLOM_EVAL_H
 #define GLOM_EVAL_H
 #include <memory>
+#include <span>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -34,4 +35,12 @@ shared_ptr<Expr> eval(const shared_ptr<Context>& ctx, shared_ptr<Pair> rest);
 shared_ptr<Context> eval_apply_context(const shared_ptr<Context>& ctx, const shared_ptr<Expr>& proc, const shared_ptr<Context>& current_parent,
                                               const vector<Param>& params, shared_ptr<Pair>&& args);
 
+// Calls an evaluated procedure on evaluated arguments, binding them directly rather than evaluating a call form
+shared_ptr<Expr> apply_procedure(const shared_ptr<Context>& ctx, const shared_ptr<Expr>& proc,
+                                 std::span<const shared_ptr<Expr>> args);
+// Like apply_procedure, but a lambda call comes back as a continuation for the evaluator to run
+// in the calling primitive's tail position; only for results a primitive returns to eval
+shared_ptr<Expr> tail_apply_procedure(const shared_ptr<Context>& ctx, const shared_ptr<Expr>& proc,
+                                      std::span<const shared_ptr<Expr>> args);
+
 #endif //GLOM_EVAL_H
\ No newline at end of file
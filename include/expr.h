@@ -5,12 +5,18 @@
 #ifndef GLOM_EXPR_H
 #define GLOM_EXPR_H
 
+#include <iterator>
 #include <vector>
 #include <string>
 #include <memory>
 #include <variant>
 #include <unordered_set>
 #include <shared_mutex>
+#include "hamt.h"
+#include "pvector.h"
+#include "record.h"
+#include "hash_table.h"
+#include "numvector.h"
 #include "primitive.h"
 #include "type.h"
 
@@ -23,6 +29,10 @@ using std::monostate;
 
 class Context;
 class Lambda;
+class Expr;
+
+// Contents of an R5RS vector, shared so that vector-set! is visible through every reference
+using Vector = vector<shared_ptr<Expr>>;
 
 class Pair : public std::enable_shared_from_this<Pair>
 {
@@ -32,6 +42,7 @@ class Pair : public std::enable_shared_from_this<Pair>
     Pair();
     explicit Pair(shared_ptr<Expr> expr);
     explicit Pair(shared_ptr<Expr> expr, shared_ptr<Expr> next);
+    friend class ListBuilder;
 public:
     static const shared_ptr<Pair> EMPTY;
     [[nodiscard]] shared_ptr<Expr> car() const;
@@ -44,12 +55,16 @@ public:
     static shared_ptr<Pair> single(shared_ptr<Expr> car);
     static shared_ptr<Pair> cons(shared_ptr<Expr> car, shared_ptr<Expr> cdr);
 
+    // Yields the cars of a list, then the last cdr of an improper list as a final element.
+    // It borrows the pairs, so the list must outlive it and not be relinked while it runs.
     class iterator {
-        shared_ptr<Pair> current;
+        const Pair* current;
+        const shared_ptr<Expr>* tail = nullptr;
     public:
-        explicit iterator(shared_ptr<Pair> pair = nullptr);
+        explicit iterator(const Pair* pair = nullptr);
 
-        shared_ptr<Expr> operator*() const;
+        // nullptr once the list is exhausted
+        const shared_ptr<Expr>& operator*() const;
 
         iterator& operator++();
 
@@ -60,13 +75,50 @@ public:
         bool operator!=(const iterator& other) const;
     };
 
-    iterator begin() {
-        return empty() ? end() : iterator(shared_from_this());
+    iterator begin() const {
+        return empty() ? end() : iterator(this);
     }
 
-    iterator end() {
+    iterator end() const {
         return iterator(nullptr);
     }
+
+    // Walks the pairs of a list and, once they run out, holds what the list ends with: NIL
+    // for a proper list, anything else for an improper one. Borrows like iterator.
+    class cursor {
+        const Pair* current;
+        const shared_ptr<Expr>* rest;
+    public:
+        explicit cursor(const Pair* pair);
+
+        [[nodiscard]] bool done() const;
+
+        [[nodiscard]] const Pair* pair() const;
+
+        // The car of the current pair
+        const shared_ptr<Expr>& operator*() const;
+
+        cursor& operator++();
+
+        // Only meaningful once done
+        [[nodiscard]] const shared_ptr<Expr>& tail() const;
+
+        [[nodiscard]] cursor begin() const {
+            return *this;
+        }
+
+        [[nodiscard]] std::default_sentinel_t end() const {
+            return {};
+        }
+
+        bool operator==(std::default_sentinel_t) const {
+            return done();
+        }
+    };
+
+    [[nodiscard]] cursor walk() const {
+        return cursor(this);
+    }
 };
 
 class SymbolPool {
@@ -104,7 +156,15 @@ using ExprValue = std::variant<
     shared_ptr<Lambda>,
     shared_ptr<Primitive>,
     shared_ptr<Pair>,
-    unique_ptr<Continuation>
+    unique_ptr<Continuation>,
+    shared_ptr<NumVector>,        // SRFI-4 homogeneous numeric vector
+    shared_ptr<Vector>,           // R5RS vector
+    shared_ptr<HashTable>,        // SRFI-69 hash table
+    shared_ptr<const PersistentMap>,
+    shared_ptr<const PersistentSet>,
+    shared_ptr<const PVector>,
+    shared_ptr<const RecordType>, // SRFI-9 record type
+    shared_ptr<Record>
 >;
 
 /**
@@ -117,14 +177,29 @@ using ExprValue = std::variant<
  * - Lambda: Represents a lambda function. (Only constructed in runtime)
  * - Primitive: Represents a primitive members. (Only constructed in c++)
  * - Continuation: Represents a continuation. (Only constructed in runtime)
+ * - NumVector: Represents a mutable vector of unboxed numbers.
+ * - Vector: Represents a mutable vector of arbitrary expressions.
+ * - HashTable: Represents a mutable hash table.
+ * - PersistentMap/PersistentSet: Represent immutable maps and sets.
+ * - PVector: Represents immutable vectors.
+ * - RecordType/Record: Represent SRFI-9 record types and their instances.
  * - None: Represents None.
  */
 class Expr {
     ExprValue value;
+    friend class ListBuilder;
     explicit Expr(std::unique_ptr<Continuation>&& v);
     explicit Expr(shared_ptr<Pair>&& v);
     explicit Expr(shared_ptr<Lambda>&& v);
     explicit Expr(shared_ptr<Primitive>&& v);
+    explicit Expr(shared_ptr<NumVector>&& v);
+    explicit Expr(shared_ptr<Vector>&& v);
+    explicit Expr(shared_ptr<HashTable>&& v);
+    explicit Expr(shared_ptr<const PersistentMap>&& v);
+    explicit Expr(shared_ptr<const PersistentSet>&& v);
+    explicit Expr(shared_ptr<const PVector>&& v);
+    explicit Expr(shared_ptr<const RecordType>&& v);
+    explicit Expr(shared_ptr<Record>&& v);
     explicit Expr(std::unique_ptr<string>&& v);
     explicit Expr(string_view v);
     explicit Expr(integer v);
@@ -133,7 +208,8 @@ class Expr {
 public:
     explicit Expr(bool v);
     explicit Expr();
-    [[nodiscard]] integer as_number_int() const;
+    [[nodiscard]] const integer& as_number_int() const;
+    [[nodiscard]] int64_t as_fixnum() const;
     [[nodiscard]] const rational& as_number_rat() const;
     [[nodiscard]] real as_number_real() const;
     [[nodiscard]] real to_number_real() const;
@@ -142,9 +218,19 @@ public:
     [[nodiscard]] const string_view& as_symbol() const;
     [[nodiscard]] bool as_boolean() const;
     [[nodiscard]] shared_ptr<Pair> as_pair() const;
+    // The pair itself, without taking a reference to it
+    [[nodiscard]] const Pair& as_pair_ref() const;
     [[nodiscard]] shared_ptr<Lambda> as_lambda() const;
     [[nodiscard]] shared_ptr<Primitive> as_primitive() const;
     [[nodiscard]] Continuation& as_cont() const;
+    [[nodiscard]] shared_ptr<NumVector> as_numvector() const;
+    [[nodiscard]] shared_ptr<Vector> as_vector() const;
+    [[nodiscard]] shared_ptr<HashTable> as_hash_table() const;
+    [[nodiscard]] const PersistentMap& as_persistent_map() const;
+    [[nodiscard]] const PersistentSet& as_persistent_set() const;
+    [[nodiscard]] const PVector& as_pvector() const;
+    [[nodiscard]] shared_ptr<const RecordType> as_record_type() const;
+    [[nodiscard]] Record& as_record() const;
     [[nodiscard]] string to_string() const;
     [[nodiscard]] bool to_boolean() const;
     [[nodiscard]] bool is_nil() const;
@@ -153,6 +239,7 @@ public:
     [[nodiscard]] bool is_nothing() const;
     [[nodiscard]] bool is_number() const;
     [[nodiscard]] bool is_number_int() const;
+    [[nodiscard]] bool is_fixnum() const;
     [[nodiscard]] bool is_number_rat() const;
     [[nodiscard]] bool is_number_real() const;
     [[nodiscard]] bool is_string() const;
@@ -162,6 +249,14 @@ public:
     [[nodiscard]] bool is_symbol() const;
     [[nodiscard]] bool is_primitive() const;
     [[nodiscard]] bool is_cont() const;
+    [[nodiscard]] bool is_numvector() const;
+    [[nodiscard]] bool is_vector() const;
+    [[nodiscard]] bool is_hash_table() const;
+    [[nodiscard]] bool is_persistent_map() const;
+    [[nodiscard]] bool is_persistent_set() const;
+    [[nodiscard]] bool is_pvector() const;
+    [[nodiscard]] bool is_record_type() const;
+    [[nodiscard]] bool is_record() const;
     void print() const;
     
     static const shared_ptr<Expr> TRUE;
@@ -180,6 +275,14 @@ public:
     static shared_ptr<Expr> make_primitive(shared_ptr<Primitive> v);
     static shared_ptr<Expr> make_pair(shared_ptr<Pair> v);
     static shared_ptr<Expr> make_cont(unique_ptr<Continuation> v);
+    static shared_ptr<Expr> make_numvector(shared_ptr<NumVector> v);
+    static shared_ptr<Expr> make_vector(shared_ptr<Vector> v);
+    static shared_ptr<Expr> make_hash_table(shared_ptr<HashTable> v);
+    static shared_ptr<Expr> make_persistent_map(PersistentMap v);
+    static shared_ptr<Expr> make_persistent_set(PersistentSet v);
+    static shared_ptr<Expr> make_pvector(PVector v);
+    static shared_ptr<Expr> make_record_type(RecordType v);
+    static shared_ptr<Expr> make_record(Record v);
 };
 
 
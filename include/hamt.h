@@ -0,0 +1,73 @@
+//
+// Created by glom on 11/7/25.
+//
+
+#ifndef GLOM_HAMT_H
+#define GLOM_HAMT_H
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+class Expr;
+
+/**
+ * An immutable hash array mapped trie from Exprs to Exprs, compared with equal?.
+ *
+ * Each node splits on the next five bits of the key hash and keeps its inline entries and
+ * its subtrees in two popcount-indexed arrays. Updates copy only the nodes on the path to
+ * the key and share everything else with the original, so assoc and dissoc are O(log n)
+ * and every version stays valid. Nodes are never mutated after construction, so a trie
+ * can be read from any number of threads. Keys whose full 64-bit hashes collide share a
+ * collision node below the last level.
+ */
+class Hamt
+{
+public:
+    using Entry = std::pair<std::shared_ptr<Expr>, std::shared_ptr<Expr>>;
+
+private:
+    struct Node;
+    using NodePtr = std::shared_ptr<const Node>;
+
+    NodePtr root;
+    size_t count = 0;
+
+    Hamt(NodePtr root, size_t count);
+
+public:
+    Hamt() = default;
+
+    [[nodiscard]] size_t size() const;
+    [[nodiscard]] bool empty() const;
+
+    // The stored entry for key, or nullptr; valid as long as this trie
+    [[nodiscard]] const Entry* find(const std::shared_ptr<Expr>& key) const;
+    // A trie with key bound to value; returns this trie if it already was
+    [[nodiscard]] Hamt assoc(const std::shared_ptr<Expr>& key, std::shared_ptr<Expr> value) const;
+    // A trie without key; returns this trie if key was absent
+    [[nodiscard]] Hamt dissoc(const std::shared_ptr<Expr>& key) const;
+
+    [[nodiscard]] std::vector<Entry> entries() const;
+    // Sum of the key hashes, independent of insertion order
+    [[nodiscard]] size_t hash() const;
+};
+
+// A persistent map; the Expr wrapper of a Hamt
+class PersistentMap : public Hamt
+{
+public:
+    PersistentMap() = default;
+    explicit PersistentMap(Hamt trie) : Hamt(std::move(trie)) {}
+};
+
+// A persistent set: a Hamt whose entries carry no value
+class PersistentSet : public Hamt
+{
+public:
+    PersistentSet() = default;
+    explicit PersistentSet(Hamt trie) : Hamt(std::move(trie)) {}
+};
+
+#endif //GLOM_HAMT_H
@@ -0,0 +1,86 @@
+//
+// Created by glom on 11/7/25.
+//
+
+#ifndef GLOM_HASH_TABLE_H
+#define GLOM_HASH_TABLE_H
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+class Expr;
+
+/**
+ * A mutable SRFI-69 hash table from Exprs to Exprs.
+ *
+ * Open addressing with linear probing over a power-of-two slot array. Each slot caches the
+ * full hash of its key, so a probe only runs the equivalence on a hash match. Deleted slots
+ * become tombstones and are dropped on the next rehash; the table grows once live and dead
+ * slots pass three quarters of the capacity.
+ *
+ * The hash of each equivalence agrees with the matching predicate:
+ * - EQ: eq?, fixnums by value, symbols by name, everything else by identity.
+ * - EQV: eqv?, numbers by numeric value, strings by contents.
+ * - EQUAL: equal?, additionally pairs and vectors by structure. Only a bounded prefix of a
+ *   structure is hashed, so cyclic keys are fine.
+ */
+class HashTable
+{
+public:
+    enum class Equivalence
+    {
+        EQ,
+        EQV,
+        EQUAL,
+    };
+
+    using Entry = std::pair<std::shared_ptr<Expr>, std::shared_ptr<Expr>>;
+
+private:
+    enum class SlotState : uint8_t
+    {
+        EMPTY,
+        FULL,
+        DELETED,
+    };
+
+    struct Slot
+    {
+        std::shared_ptr<Expr> key;
+        std::shared_ptr<Expr> value;
+        size_t hash = 0;
+        SlotState state = SlotState::EMPTY;
+    };
+
+    Equivalence equivalence;
+    std::vector<Slot> slots;
+    size_t count = 0;
+    size_t tombstones = 0;
+
+    [[nodiscard]] bool matches(const Slot& slot, const std::shared_ptr<Expr>& key, size_t hash) const;
+    // Index of the slot holding key, or slots.size() if absent
+    [[nodiscard]] size_t find(const std::shared_ptr<Expr>& key, size_t hash) const;
+    void rehash(size_t capacity);
+
+public:
+    explicit HashTable(Equivalence equivalence);
+
+    [[nodiscard]] Equivalence get_equivalence() const;
+    [[nodiscard]] size_t size() const;
+
+    // The value bound to key, or nullptr
+    [[nodiscard]] std::shared_ptr<Expr> get(const std::shared_ptr<Expr>& key) const;
+    void set(const std::shared_ptr<Expr>& key, std::shared_ptr<Expr> value);
+    // Whether key was bound
+    bool remove(const std::shared_ptr<Expr>& key);
+    void clear();
+
+    // A snapshot of the bindings, in slot order
+    [[nodiscard]] std::vector<Entry> entries() const;
+
+    static size_t hash(Equivalence equivalence, const Expr& expr);
+};
+
+#endif //GLOM_HASH_TABLE_H
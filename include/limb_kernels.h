@@ -0,0 +1,46 @@
+//
+// Created by glom on 11/4/25.
+//
+
+#ifndef GLOM_LIMB_KERNELS_H
+#define GLOM_LIMB_KERNELS_H
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Carry-chain kernels over spans of 64-bit limbs (least significant first), the inner loops
+ * of all UBigInt arithmetic.
+ *
+ * On x86-64 the add/sub kernels compile to adc/sbb chains, and the multiply kernels use
+ * an inline-asm mulx/adcx/adox loop when the CPU reports BMI2 and ADX at runtime. Other targets use a
+ * portable 128-bit implementation. The output span may alias the first input span.
+ */
+namespace limb_kernels
+{
+    // r = a + b over n limbs, returns the carry out
+    uint64_t add_n(uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n);
+    // r = a - b over n limbs, returns the borrow out
+    uint64_t sub_n(uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n);
+    // r = a + carry over n limbs, returns the carry out
+    uint64_t add_1(uint64_t* r, const uint64_t* a, size_t n, uint64_t carry);
+    // r = a - borrow over n limbs, returns the borrow out
+    uint64_t sub_1(uint64_t* r, const uint64_t* a, size_t n, uint64_t borrow);
+    // r += a * b over n limbs, returns the high limb carried out
+    uint64_t addmul_1(uint64_t* r, const uint64_t* a, size_t n, uint64_t b);
+    // r -= a * b over n limbs, returns the high limb borrowed out
+    uint64_t submul_1(uint64_t* r, const uint64_t* a, size_t n, uint64_t b);
+
+    // Whether addmul_1/submul_1 dispatch to the BMI2/ADX kernels
+    bool has_adx();
+
+    // Reference implementations, also the fallback on targets without carry intrinsics
+    namespace portable
+    {
+        uint64_t add_n(uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n);
+        uint64_t sub_n(uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n);
+        uint64_t addmul_1(uint64_t* r, const uint64_t* a, size_t n, uint64_t b);
+        uint64_t submul_1(uint64_t* r, const uint64_t* a, size_t n, uint64_t b);
+    }
+}
+
+#endif //GLOM_LIMB_KERNELS_H
@@ -0,0 +1,37 @@
+//
+// Created by glom on 11/10/25.
+//
+
+#ifndef GLOM_LIST_BUILDER_H
+#define GLOM_LIST_BUILDER_H
+#include <memory>
+
+class Expr;
+class Pair;
+
+/**
+ * Builds a list front to back in one pass.
+ *
+ * The cells come from a per-thread arena that hands out memory in 4 KB chunks. A list
+ * built in one go therefore sits contiguously, each element's Pair next to the Expr that
+ * links to it, and costs one allocation per chunk instead of two per element. The cells
+ * are ordinary pairs, so set-car! and set-cdr! behave as usual. A chunk is returned to the
+ * heap once its last cell is freed, on whichever thread that happens.
+ */
+class ListBuilder
+{
+    std::shared_ptr<Expr> head;
+    std::shared_ptr<Pair> tail;
+
+public:
+    void push_back(std::shared_ptr<Expr> value);
+    // Ends the list with rest instead of the empty list, as in a dotted list
+    void set_tail(std::shared_ptr<Expr> rest);
+    [[nodiscard]] bool empty() const;
+
+    // The list built so far; the empty list if nothing was pushed
+    [[nodiscard]] std::shared_ptr<Expr> build() const;
+    [[nodiscard]] std::shared_ptr<Pair> build_pair() const;
+};
+
+#endif //GLOM_LIST_BUILDER_H
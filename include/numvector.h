@@ -0,0 +1,79 @@
+//
+// Created by glom on 11/6/25.
+//
+
+#ifndef GLOM_NUMVECTOR_H
+#define GLOM_NUMVECTOR_H
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <variant>
+#include <vector>
+
+/**
+ * A SRFI-4 homogeneous numeric vector: unboxed elements of one kind in a contiguous buffer.
+ * - F64: IEEE doubles (f64vector). Storing a real rounds it to double. Elements print in the
+ *   shortest form that reads back to the same double, and are read back as the real with that
+ *   same form, so (f64vector-ref (f64vector 0.1) 0) is = to the literal 0.1 in both flonum
+ *   builds. A literal with more precision than a double has comes back rounded.
+ * - S64: signed 64-bit integers (s64vector), read back as fixnums.
+ * - U8: bytes (u8vector).
+ */
+class NumVector
+{
+public:
+    enum class Kind
+    {
+        F64,
+        S64,
+        U8,
+    };
+
+private:
+    std::variant<std::vector<double>, std::vector<int64_t>, std::vector<uint8_t>> elements;
+
+public:
+    NumVector(Kind kind, size_t size);
+    explicit NumVector(std::vector<double> values);
+    explicit NumVector(std::vector<int64_t> values);
+    explicit NumVector(std::vector<uint8_t> values);
+
+    [[nodiscard]] Kind kind() const;
+    [[nodiscard]] size_t size() const;
+
+    // Element storage, only valid for the matching kind
+    [[nodiscard]] std::vector<double>& f64();
+    [[nodiscard]] const std::vector<double>& f64() const;
+    [[nodiscard]] std::vector<int64_t>& s64();
+    [[nodiscard]] const std::vector<int64_t>& s64() const;
+    [[nodiscard]] std::vector<uint8_t>& u8();
+    [[nodiscard]] const std::vector<uint8_t>& u8() const;
+
+    // The SRFI-4 tag of the kind: "f64", "s64" or "u8"
+    static std::string tag(Kind kind);
+
+    [[nodiscard]] std::string to_string() const;
+
+    bool operator==(const NumVector& other) const;
+};
+
+/**
+ * Bulk f64 kernels, written with GCC vector extensions so each loop handles four lanes
+ * at a time. On x86-64 they are compiled for AVX2 and baseline SSE2 and picked at load
+ * time. Reductions keep per-lane partial results, so sums may differ from a strict
+ * left-to-right fold in the last bits.
+ */
+namespace numvector_kernels
+{
+    double sum(const double* a, size_t n);
+    double dot(const double* a, const double* b, size_t n);
+    // r = a + b, r = a * b and r = a * s element-wise; r may alias a or b
+    void add(double* r, const double* a, const double* b, size_t n);
+    void mul(double* r, const double* a, const double* b, size_t n);
+    void scale(double* r, const double* a, double s, size_t n);
+    // n must be positive; a NaN anywhere makes the result NaN
+    double min(const double* a, size_t n);
+    double max(const double* a, size_t n);
+}
+
+#endif //GLOM_NUMVECTOR_H
@@ -10,6 +10,7 @@
 #include <string>
 #include <memory>
 #include "eval.h"
+#include "numvector.h"
 
 struct Continuation;
 class Pair;
@@ -39,10 +40,19 @@ namespace primitives_utils
     bool generic_num_eq(shared_ptr<Expr>& a, shared_ptr<Expr>& b);
     bool generic_num_lt(shared_ptr<Expr>& a, shared_ptr<Expr>& b);
     bool generic_num_gt(shared_ptr<Expr>& a, shared_ptr<Expr>& b);
+    // The eq?, eqv? and equal? predicates on evaluated values
+    bool is_eq(const shared_ptr<Expr>& a, const shared_ptr<Expr>& b);
+    bool is_eqv(const shared_ptr<Expr>& a, const shared_ptr<Expr>& b);
+    bool is_equal(const shared_ptr<Expr>& a, const shared_ptr<Expr>& b);
     void coerce_number(shared_ptr<Expr>& a, shared_ptr<Expr>& b);
     void expect_1_arg(const string& proc, const shared_ptr<Pair>& args, shared_ptr<Expr>& a);
+    void expect_1_or_2_args(const string& proc, const shared_ptr<Pair>& args, shared_ptr<Expr>& a, shared_ptr<Expr>& b);
     void expect_2_args(const string& proc, const shared_ptr<Pair>& args, shared_ptr<Expr>& a, shared_ptr<Expr>& b);
     void expect_2_or_3_args(const string& proc, const shared_ptr<Pair>& args, shared_ptr<Expr>& a, shared_ptr<Expr>& b, shared_ptr<Expr>& c);
+    void expect_3_args(const string& proc, const shared_ptr<Pair>& args, shared_ptr<Expr>& a, shared_ptr<Expr>& b, shared_ptr<Expr>& c);
+    size_t expect_index(const string& proc, const shared_ptr<Context>& context, shared_ptr<Expr> expr, size_t size);
+    void expect_list(const string& proc, const shared_ptr<Expr>& list);
+    vector<shared_ptr<Expr>> eval_arguments(const shared_ptr<Context>& context, const shared_ptr<Pair>& args);
     void take_car(const string& proc, const shared_ptr<Expr>& list, const shared_ptr<Expr>& expr, shared_ptr<Expr>& car);
     void take_cdr(const string& proc, const shared_ptr<Expr>& list, const shared_ptr<Expr>& expr, shared_ptr<Expr>& cdr);
 }
@@ -64,6 +74,10 @@ namespace primitives
     shared_ptr<Expr> quotient(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
     shared_ptr<Expr> remainder(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
     shared_ptr<Expr> modulo(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> exact_integer_expt_mod(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> factorial(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> binomial(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> product(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
     // Math functions
     shared_ptr<Expr> exponentiation(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
     shared_ptr<Expr> logarithm(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
@@ -75,7 +89,33 @@ namespace primitives
     shared_ptr<Expr> arctangent(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
     shared_ptr<Expr> square_root(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);;
     shared_ptr<Expr> square_root_integer(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> exact_integer_sqrt(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> exact_integer_root(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
     shared_ptr<Expr> exponential(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    // Bitwise operations
+    shared_ptr<Expr> bitwise_and(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> bitwise_or(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> bitwise_xor(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> bitwise_not(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> arithmetic_shift(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> bit_count(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> integer_length(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    // Homogeneous numeric vectors (SRFI-4), instantiated for every NumVector::Kind
+    template <NumVector::Kind K> shared_ptr<Expr> make_numvector(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    template <NumVector::Kind K> shared_ptr<Expr> numvector(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    template <NumVector::Kind K> shared_ptr<Expr> is_numvector(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    template <NumVector::Kind K> shared_ptr<Expr> numvector_length(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    template <NumVector::Kind K> shared_ptr<Expr> numvector_ref(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    template <NumVector::Kind K> shared_ptr<Expr> numvector_set(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    template <NumVector::Kind K> shared_ptr<Expr> numvector_to_list(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    template <NumVector::Kind K> shared_ptr<Expr> list_to_numvector(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> f64vector_sum(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> f64vector_dot(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> f64vector_add(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> f64vector_mul(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> f64vector_scale(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> f64vector_min(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> f64vector_max(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
     // Number comparisons
     shared_ptr<Expr> eq(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
     shared_ptr<Expr> lt(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
@@ -170,6 +210,90 @@ namespace primitives
     shared_ptr<Expr> list(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
     shared_ptr<Expr> append(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
     shared_ptr<Expr> length(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> map(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> for_each(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> filter(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> fold_left(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> fold_right(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> reduce(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> sort(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> sort_in_place(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> list_sort(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> merge(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> list_ref(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> list_tail(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> reverse(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> reverse_in_place(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> last_pair(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> list_copy(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> memq(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> memv(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> member(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> assq(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> assv(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> assoc(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    // Vector
+    shared_ptr<Expr> vector_of(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> make_vector(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> is_vector(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> vector_length(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> vector_ref(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> vector_set(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> vector_fill(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> vector_to_list(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> list_to_vector(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    // Hash table
+    shared_ptr<Expr> make_hash_table(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> is_hash_table(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> hash_table_size(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> hash_table_ref(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> hash_table_ref_default(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> hash_table_set(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> hash_table_delete(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> hash_table_exists(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> hash_table_update(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> hash_table_update_default(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> hash_table_walk(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> hash_table_fold(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> hash_table_keys(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> hash_table_values(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> hash_table_to_alist(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> alist_to_hash_table(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> hash_table_copy(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> hash_table_clear(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    // Persistent map and set
+    shared_ptr<Expr> persistent_map(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> is_persistent_map(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> map_ref(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> map_assoc(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> map_dissoc(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> map_contains(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> map_count(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> map_keys(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> map_values(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> map_to_alist(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> alist_to_map(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> persistent_set(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> is_persistent_set(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> set_add(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> set_remove(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> set_contains(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> set_count(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> set_to_list(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> list_to_set(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    // Persistent vector
+    shared_ptr<Expr> pvector(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> is_pvector(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> pvector_length(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> pvector_ref(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> pvector_set(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> pvector_push(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> pvector_append(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> pvector_slice(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> pvector_to_list(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    shared_ptr<Expr> list_to_pvector(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
+    // Record
+    shared_ptr<Expr> define_record_type(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
     // Mutable Context
     shared_ptr<Expr> set(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
     shared_ptr<Expr> set_car(const shared_ptr<Context>& context, shared_ptr<Pair>&& args);
@@ -0,0 +1,52 @@
+//
+// Created by glom on 11/8/25.
+//
+
+#ifndef GLOM_PVECTOR_H
+#define GLOM_PVECTOR_H
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+class Expr;
+
+/**
+ * An immutable relaxed radix balanced (RRB) tree of Exprs.
+ *
+ * Leaves hold up to 32 elements and inner nodes up to 32 subtrees. A node whose subtrees
+ * are all full except the last is indexed by radix alone; any other node carries a table
+ * of cumulative sizes that lookups scan from the radix guess. Concatenation merges the
+ * two trees along their facing edges and redistributes only the nodes on that seam, so
+ * ref, set, push, append and slice are all O(log n) and share everything else with the
+ * original vectors. Nodes are never mutated after construction.
+ */
+class PVector
+{
+    struct Node;
+    using NodePtr = std::shared_ptr<const Node>;
+
+    NodePtr root;
+    size_t count = 0;
+    // Bits of the index consumed above the leaves; zero when the root is a leaf
+    unsigned shift = 0;
+
+    PVector(NodePtr root, unsigned shift);
+
+public:
+    PVector() = default;
+    explicit PVector(const std::vector<std::shared_ptr<Expr>>& elements);
+
+    [[nodiscard]] size_t size() const;
+    [[nodiscard]] bool empty() const;
+
+    [[nodiscard]] const std::shared_ptr<Expr>& get(size_t index) const;
+    [[nodiscard]] PVector set(size_t index, std::shared_ptr<Expr> value) const;
+    [[nodiscard]] PVector push_back(std::shared_ptr<Expr> value) const;
+    [[nodiscard]] PVector concat(const PVector& other) const;
+    // The elements in [start, end)
+    [[nodiscard]] PVector slice(size_t start, size_t end) const;
+
+    [[nodiscard]] std::vector<std::shared_ptr<Expr>> elements() const;
+};
+
+#endif //GLOM_PVECTOR_H
@@ -0,0 +1,55 @@
+//
+// Created by glom on 11/11/25.
+//
+
+#ifndef GLOM_RECORD_H
+#define GLOM_RECORD_H
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class Expr;
+
+/**
+ * A record type made by SRFI-9 define-record-type: its name and the names of its fields.
+ *
+ * The position of a field in this list is its slot in every instance. Accessors and
+ * modifiers look the slot up once, when they are defined, and afterwards only check that a
+ * record belongs to this exact type.
+ */
+class RecordType
+{
+    std::string name;
+    std::vector<std::string_view> fields;
+
+public:
+    RecordType(std::string name, std::vector<std::string_view> fields);
+
+    [[nodiscard]] const std::string& get_name() const;
+    [[nodiscard]] const std::vector<std::string_view>& get_fields() const;
+    // The slot of the named field, if the type has one
+    [[nodiscard]] std::optional<size_t> slot_of(std::string_view field) const;
+};
+
+/**
+ * An instance of a record type, holding one value per field in a contiguous slot array.
+ */
+class Record
+{
+    std::shared_ptr<const RecordType> type;
+    std::vector<std::shared_ptr<Expr>> slots;
+
+public:
+    Record(std::shared_ptr<const RecordType> type, std::vector<std::shared_ptr<Expr>> slots);
+
+    [[nodiscard]] const RecordType& get_type() const;
+    [[nodiscard]] bool is_instance_of(const RecordType& record_type) const;
+    [[nodiscard]] const std::shared_ptr<Expr>& get(size_t slot) const;
+    void set(size_t slot, std::shared_ptr<Expr> value);
+    [[nodiscard]] std::string to_string() const;
+};
+
+#endif //GLOM_RECORD_H
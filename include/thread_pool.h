@@ -0,0 +1,60 @@
+//
+// Created by glom on 11/5/25.
+//
+
+#ifndef GLOM_THREAD_POOL_H
+#define GLOM_THREAD_POOL_H
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * A fixed set of worker threads for splitting large arithmetic (see the Karatsuba
+ * recursion in bigint.cpp) across cores.
+ *
+ * The shared pool is sized from the GLOM_THREADS environment variable or the --threads
+ * command line flag, and defaults to a single thread, which runs all work on the caller.
+ */
+class ThreadPool
+{
+    struct Group;
+    struct Task
+    {
+        std::function<void()> work;
+        Group* group;
+    };
+
+    std::vector<std::thread> workers;
+    std::deque<Task> queue;
+    std::mutex mutex;
+    std::condition_variable changed;
+    bool stopping = false;
+
+    void worker_loop();
+    void stop_workers();
+    static void run_task(Task& task, std::unique_lock<std::mutex>& lock);
+
+public:
+    explicit ThreadPool(size_t threads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    static ThreadPool& instance();
+
+    // Total threads doing work, the caller included. Must not be called while work is running.
+    void resize(size_t threads);
+    [[nodiscard]] size_t size();
+
+    // Runs every task and returns once all of them finished, rethrowing the first exception.
+    // The caller runs the first task itself and then helps with queued work while it waits,
+    // so tasks may call run_all recursively without exhausting the workers.
+    void run_all(std::vector<std::function<void()>>& tasks);
+};
+
+#endif //GLOM_THREAD_POOL_H
@@ -22,6 +22,7 @@ enum TokenType
     TOKEN_SYMBOL,
     TOKEN_BOOLEAN,
     TOKEN_LPAREN,
+    TOKEN_VECTOR_LPAREN,
     TOKEN_RPAREN,
     TOKEN_QUOTE,
     TOKEN_EOI
@@ -54,6 +55,7 @@ public:
     static Token make_boolean(bool x);
     static Token make_symbol(string x);
     static Token make_left_paren();
+    static Token make_vector_left_paren();
     static Token make_right_paren();
     static Token make_quote();
     static Token make_end_of_input();
@@ -7,6 +7,9 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
 #include <utility>
 #include <variant>
 typedef __int128 int128_t;
@@ -28,13 +31,30 @@ constexpr auto LAMBDA = 7;
 constexpr auto PRIMITIVE = 8;
 constexpr auto PAIR = 9;
 constexpr auto CONTINUATION = 10;
+constexpr auto NUMVECTOR = 11;
+constexpr auto VECTOR = 12;
+constexpr auto HASH_TABLE = 13;
+constexpr auto PERSISTENT_MAP = 14;
+constexpr auto PERSISTENT_SET = 15;
+constexpr auto PVECTOR = 16;
+constexpr auto RECORD_TYPE = 17;
+constexpr auto RECORD = 18;
 
 
 class rational;
+#ifdef GLOM_FLONUM_DOUBLE
+using real = double;
+#else
 using real = long double;
+#endif
 
+// Correctly rounded parsing and shortest round-trip printing of inexact reals
 real from_string(const std::string& str);
 std::string to_string(real val, size_t base = 10);
+// The same for values stored as double (f64vector elements), whatever the width of real
+std::string f64_to_string(double val);
+// The real whose shortest form matches that of val: exactly val when real is double
+real f64_to_real(double val);
 
 class UBigInt
 {
@@ -76,6 +96,10 @@ public:
 
     UBigInt operator%(const UBigInt& other) const;
 
+    UBigInt operator<<(size_t bits) const;
+
+    UBigInt operator>>(size_t bits) const;
+
     [[nodiscard]] UBigInt pow(const UBigInt& exponent) const;
 
     bool operator==(const UBigInt& other) const;
@@ -95,10 +119,40 @@ public:
 
     [[nodiscard]] std::string to_decimal_string() const;
 
+    // Digits in radix 2, 8, 10 or 16; power-of-two radixes are read straight off the limbs
+    [[nodiscard]] std::string to_string(unsigned radix) const;
+    // Parses unsigned digits, nullopt if a character is not a digit of the radix
+    [[nodiscard]] static std::optional<UBigInt> parse(std::string_view digits, unsigned radix);
+
     bool operator<(uint64_t other) const;
 
     [[nodiscard]] std::pair<UBigInt, UBigInt> divide_single_word(uint64_t divisor) const;
 
+    // Lehmer's algorithm while both operands span several limbs, binary GCD once they fit a word
+    [[nodiscard]] static UBigInt gcd(UBigInt a, UBigInt b);
+    [[nodiscard]] static uint64_t gcd_word(uint64_t a, uint64_t b);
+
+    // Newton iterations seeded from a floating estimate of the leading bits
+    [[nodiscard]] static UBigInt isqrt(const UBigInt& n);
+    [[nodiscard]] static uint64_t isqrt_word(uint64_t n);
+    [[nodiscard]] static UBigInt iroot(const UBigInt& n, uint64_t k);
+    // Quadratic residue filter: false means n is certainly not a perfect square
+    [[nodiscard]] static bool maybe_square(const UBigInt& n);
+
+    // base^exponent mod modulus by sliding-window exponentiation, with Montgomery reduction for odd moduli
+    [[nodiscard]] static UBigInt expt_mod(const UBigInt& base, const UBigInt& exponent, const UBigInt& modulus);
+
+    // Balanced product tree, so the large multiplications get operands of similar size
+    [[nodiscard]] static UBigInt product(const std::vector<UBigInt>& factors);
+    // Prime-swing factorial: n! = (n/2)!^2 * swing(n), the swing built from prime powers
+    [[nodiscard]] static UBigInt factorial(uint64_t n);
+    [[nodiscard]] static UBigInt binomial(uint64_t n, uint64_t k);
+
+    // Correctly rounded (half to even) from the leading bits, without a decimal round trip
+    [[nodiscard]] real to_real() const;
+    // num / den correctly rounded, by a single division scaled to a word's worth of quotient
+    [[nodiscard]] static real ratio_to_real(const UBigInt& num, const UBigInt& den);
+
 private:
     [[nodiscard]] std::pair<UBigInt, UBigInt> divide_long_division(const UBigInt& divisor) const;
 };
@@ -152,6 +206,17 @@ public:
     BigInt operator%(const BigInt& other) const;
 
     [[nodiscard]] BigInt pow(const UBigInt& exponent) const;
+
+    // Bitwise operations treat the value as an infinitely sign-extended two's complement number
+    [[nodiscard]] BigInt bitwise_and(const BigInt& other) const;
+    [[nodiscard]] BigInt bitwise_or(const BigInt& other) const;
+    [[nodiscard]] BigInt bitwise_xor(const BigInt& other) const;
+    [[nodiscard]] BigInt bitwise_not() const;
+    // Left for a positive shift, floor division by a power of two for a negative one
+    [[nodiscard]] BigInt arithmetic_shift(int64_t shift) const;
+    // Set bits of a non-negative value, clear bits of a negative one (SRFI 151)
+    [[nodiscard]] uint64_t bit_count() const;
+    [[nodiscard]] uint64_t integer_length() const;
     bool operator==(const BigInt& other) const;
 
     bool operator!=(const BigInt& other) const;
@@ -236,6 +301,20 @@ public:
     [[nodiscard]] integer remainder(const integer& mod) const;
     [[nodiscard]] integer modulo(const integer& mod) const;
     [[nodiscard]] integer pow(const integer& exponent) const;
+    [[nodiscard]] integer expt_mod(const integer& exponent, const integer& modulus) const;
+
+    // Balanced product trees, see UBigInt::product
+    [[nodiscard]] static integer product(std::vector<integer> factors);
+    [[nodiscard]] static integer factorial(uint64_t n);
+    [[nodiscard]] static integer binomial(uint64_t n, uint64_t k);
+
+    [[nodiscard]] integer bitwise_and(const integer& other) const;
+    [[nodiscard]] integer bitwise_or(const integer& other) const;
+    [[nodiscard]] integer bitwise_xor(const integer& other) const;
+    [[nodiscard]] integer bitwise_not() const;
+    [[nodiscard]] integer arithmetic_shift(int64_t shift) const;
+    [[nodiscard]] uint64_t bit_count() const;
+    [[nodiscard]] uint64_t integer_length() const;
 
     bool operator==(const integer& other) const;
     bool operator!=(const integer& other) const;
@@ -251,6 +330,9 @@ public:
     [[nodiscard]] integer abs() const;
 
     [[nodiscard]] std::string to_decimal_string() const;
+    [[nodiscard]] std::string to_string(unsigned radix) const;
+    // Optionally signed digits in radix 2, 8, 10 or 16, nullopt if malformed
+    [[nodiscard]] static std::optional<integer> parse(std::string_view text, unsigned radix);
 
     [[nodiscard]] real to_real() const;
 
@@ -260,6 +342,8 @@ public:
 
     [[nodiscard]] std::variant<integer, real> sqrt() const;
     [[nodiscard]] integer isqrt() const;
+    // Integer k-th root, truncated toward zero
+    [[nodiscard]] integer iroot(uint64_t k) const;
 };
 
 class rational {
@@ -271,6 +355,14 @@ public:
 
     static integer gcd(const integer& a, const integer& b);
 
+    // Deferred normalization: the *_unreduced operations skip the gcd step, so a chain of
+    // additions/multiplications pays for a single normalize() once the result is used.
+    static rational unreduced(integer num, integer den);
+    [[nodiscard]] rational add_unreduced(const rational& other) const;
+    [[nodiscard]] rational sub_unreduced(const rational& other) const;
+    [[nodiscard]] rational mul_unreduced(const rational& other) const;
+    [[nodiscard]] bool should_reduce() const;
+
     rational();
     explicit rational(integer value);
     explicit rational(int64_t value);
@@ -317,6 +409,7 @@ public:
     [[nodiscard]] rational pow(const integer& exponent) const;
 
     [[nodiscard]] std::string to_rational_string() const;
+    [[nodiscard]] std::string to_string(unsigned radix) const;
 
     [[nodiscard]] real to_inexact() const;
 
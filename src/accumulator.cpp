@@ -0,0 +1,235 @@
+//
+// Created by glom on 11/2/25.
+//
+#include <algorithm>
+#include <limits>
+
+#include "accumulator.h"
+
+NumberAccumulator::NumberAccumulator(const Expr& number) : rank(rank_of(number))
+{
+    switch (rank)
+    {
+    case Rank::FIXNUM:
+        fixnum = number.as_fixnum();
+        break;
+    case Rank::INTEGER:
+        exact_int = number.as_number_int();
+        break;
+    case Rank::RATIONAL:
+        exact_rat = number.as_number_rat();
+        break;
+    case Rank::REAL:
+        inexact = number.as_number_real();
+        break;
+    }
+}
+
+NumberAccumulator::Rank NumberAccumulator::rank_of(const Expr& number)
+{
+    if (number.is_fixnum())
+    {
+        return Rank::FIXNUM;
+    }
+    if (number.is_number_int())
+    {
+        return Rank::INTEGER;
+    }
+    if (number.is_number_rat())
+    {
+        return Rank::RATIONAL;
+    }
+    return Rank::REAL;
+}
+
+void NumberAccumulator::promote(const Rank target)
+{
+    while (rank < target)
+    {
+        switch (rank)
+        {
+        case Rank::FIXNUM:
+            exact_int = integer(fixnum);
+            rank = Rank::INTEGER;
+            break;
+        case Rank::INTEGER:
+            exact_rat = rational::unreduced(std::move(exact_int), integer(1));
+            rank = Rank::RATIONAL;
+            break;
+        case Rank::RATIONAL:
+            exact_rat.normalize();
+            inexact = exact_rat.to_inexact();
+            rank = Rank::REAL;
+            break;
+        case Rank::REAL:
+            return;
+        }
+    }
+}
+
+void NumberAccumulator::add(const Expr& number)
+{
+    if (rank == Rank::FIXNUM && number.is_fixnum())
+    {
+        if (int64_t result; !__builtin_add_overflow(fixnum, number.as_fixnum(), &result)) [[likely]]
+        {
+            fixnum = result;
+            return;
+        }
+    }
+    promote(std::max(std::max(rank, rank_of(number)), Rank::INTEGER));
+    switch (rank)
+    {
+    case Rank::INTEGER:
+        exact_int = exact_int + number.as_number_int();
+        break;
+    case Rank::RATIONAL:
+        exact_rat = number.is_number_rat() ? exact_rat.add_unreduced(number.as_number_rat())
+                                           : exact_rat.add_unreduced(rational(number.as_number_int()));
+        if (exact_rat.should_reduce())
+        {
+            exact_rat.normalize();
+        }
+        break;
+    default:
+        inexact += number.to_number_real();
+        break;
+    }
+}
+
+void NumberAccumulator::sub(const Expr& number)
+{
+    if (rank == Rank::FIXNUM && number.is_fixnum())
+    {
+        if (int64_t result; !__builtin_sub_overflow(fixnum, number.as_fixnum(), &result)) [[likely]]
+        {
+            fixnum = result;
+            return;
+        }
+    }
+    promote(std::max(std::max(rank, rank_of(number)), Rank::INTEGER));
+    switch (rank)
+    {
+    case Rank::INTEGER:
+        exact_int = exact_int - number.as_number_int();
+        break;
+    case Rank::RATIONAL:
+        exact_rat = number.is_number_rat() ? exact_rat.sub_unreduced(number.as_number_rat())
+                                           : exact_rat.sub_unreduced(rational(number.as_number_int()));
+        if (exact_rat.should_reduce())
+        {
+            exact_rat.normalize();
+        }
+        break;
+    default:
+        inexact -= number.to_number_real();
+        break;
+    }
+}
+
+void NumberAccumulator::mul(const Expr& number)
+{
+    if (rank == Rank::FIXNUM && number.is_fixnum())
+    {
+        if (int64_t result; !__builtin_mul_overflow(fixnum, number.as_fixnum(), &result)) [[likely]]
+        {
+            fixnum = result;
+            return;
+        }
+    }
+    promote(std::max(std::max(rank, rank_of(number)), Rank::INTEGER));
+    switch (rank)
+    {
+    case Rank::INTEGER:
+        exact_int = exact_int * number.as_number_int();
+        break;
+    case Rank::RATIONAL:
+        exact_rat = number.is_number_rat() ? exact_rat.mul_unreduced(number.as_number_rat())
+                                           : exact_rat.mul_unreduced(rational(number.as_number_int()));
+        if (exact_rat.should_reduce())
+        {
+            exact_rat.normalize();
+        }
+        break;
+    default:
+        inexact *= number.to_number_real();
+        break;
+    }
+}
+
+void NumberAccumulator::negate()
+{
+    switch (rank)
+    {
+    case Rank::FIXNUM:
+        if (fixnum != std::numeric_limits<int64_t>::min())
+        {
+            fixnum = -fixnum;
+            return;
+        }
+        promote(Rank::INTEGER);
+        exact_int = -exact_int;
+        break;
+    case Rank::INTEGER:
+        exact_int = -exact_int;
+        break;
+    case Rank::RATIONAL:
+        exact_rat.num = -exact_rat.num;
+        break;
+    case Rank::REAL:
+        inexact = -inexact;
+        break;
+    }
+}
+
+NumberAccumulator::Rank NumberAccumulator::get_rank() const
+{
+    return rank;
+}
+
+shared_ptr<Expr> NumberAccumulator::box()
+{
+    switch (rank)
+    {
+    case Rank::FIXNUM:
+        return Expr::make_number_int(integer(fixnum));
+    case Rank::INTEGER:
+        return Expr::make_number_int(std::move(exact_int));
+    case Rank::RATIONAL:
+        exact_rat.normalize();
+        return Expr::make_number_exact(std::move(exact_rat));
+    default:
+        return Expr::make_number_real(inexact);
+    }
+}
+
+std::partial_ordering compare_numbers(const Expr& a, const Expr& b)
+{
+    if (a.is_fixnum() && b.is_fixnum()) [[likely]]
+    {
+        return a.as_fixnum() <=> b.as_fixnum();
+    }
+    if (a.is_number_real() || b.is_number_real())
+    {
+        return a.to_number_real() <=> b.to_number_real();
+    }
+    if (a.is_number_int() && b.is_number_int())
+    {
+        const auto& left = a.as_number_int();
+        const auto& right = b.as_number_int();
+        return left < right ? std::partial_ordering::less
+             : left == right ? std::partial_ordering::equivalent
+             : std::partial_ordering::greater;
+    }
+    // At least one rational: compare num_a * den_b against num_b * den_a (denominators are positive)
+    const auto& num_a = a.is_number_rat() ? a.as_number_rat().num : a.as_number_int();
+    const auto& num_b = b.is_number_rat() ? b.as_number_rat().num : b.as_number_int();
+    const integer one(1);
+    const auto& den_a = a.is_number_rat() ? a.as_number_rat().den : one;
+    const auto& den_b = b.is_number_rat() ? b.as_number_rat().den : one;
+    const integer left = num_a * den_b;
+    const integer right = num_b * den_a;
+    return left < right ? std::partial_ordering::less
+         : left == right ? std::partial_ordering::equivalent
+         : std::partial_ordering::greater;
+}
@@ -3,8 +3,16 @@
 //
 
 #include "type.h"
+#include "limb_kernels.h"
+#include "thread_pool.h"
 
+#include <array>
+#include <cmath>
 #include <cstdint>
+#include <limits>
+#include <functional>
+#include <optional>
+#include <string_view>
 #include <utility>
 #include <vector>
 #include <algorithm>
@@ -281,33 +289,16 @@ const std::vector<uint64_t>& UBigInt::get_data() const { return data; }
 
 UBigInt UBigInt::operator+(const UBigInt& other) const
 {
-    const auto& a = data;
-    const auto& b = other.data;
-    const size_t max_size = std::max(a.size(), b.size());
-
-    std::vector<uint64_t> result(max_size + 1, 0);
-    uint128_t carry = 0;
+    const auto& longer = data.size() >= other.data.size() ? data : other.data;
+    const auto& shorter = data.size() >= other.data.size() ? other.data : data;
 
-    for (size_t i = 0; i < max_size; ++i)
-    {
-        uint128_t sum = carry;
-        if (i < a.size()) sum += a[i];
-        if (i < b.size()) sum += b[i];
-
-        result[i] = static_cast<uint64_t>(sum);
-        carry = sum >> 64;
-    }
-
-    if (carry)
-    {
-        result[max_size] = static_cast<uint64_t>(carry);
-    }
-    else
-    {
-        result.pop_back();
-    }
+    std::vector<uint64_t> result(longer.size() + 1);
+    uint64_t carry = limb_kernels::add_n(result.data(), longer.data(), shorter.data(), shorter.size());
+    carry = limb_kernels::add_1(result.data() + shorter.size(), longer.data() + shorter.size(),
+                                longer.size() - shorter.size(), carry);
+    result.back() = carry;
 
-    return UBigInt(result);
+    return UBigInt(std::move(result));
 }
 
 UBigInt UBigInt::operator-(const UBigInt& other) const
@@ -319,28 +310,114 @@ UBigInt UBigInt::operator-(const UBigInt& other) const
 
     const auto& a = data;
     const auto& b = other.data;
-    std::vector<uint64_t> result(a.size(), 0);
-    uint64_t borrow = 0;
+    std::vector<uint64_t> result(a.size());
+    const uint64_t borrow = limb_kernels::sub_n(result.data(), a.data(), b.data(), b.size());
+    limb_kernels::sub_1(result.data() + b.size(), a.data() + b.size(), a.size() - b.size(), borrow);
+
+    return UBigInt(std::move(result));
+}
+
+namespace
+{
+    // Below this many limbs in the shorter operand the schoolbook loop beats Karatsuba
+    constexpr size_t KARATSUBA_THRESHOLD = 32;
+    // Above this many limbs in the shorter operand Karatsuba hands its products to the thread pool
+    constexpr size_t PARALLEL_THRESHOLD = 2048;
+
+    // r[0, an + bn) = a * b, where r is zeroed and an >= bn
+    void multiply_limbs(uint64_t* r, const uint64_t* a, size_t an, const uint64_t* b, size_t bn);
+
+    // r[0, n) += a[0, m), propagating the carry through the rest of r
+    void add_into(uint64_t* r, const size_t n, const uint64_t* a, const size_t m)
+    {
+        const uint64_t carry = limb_kernels::add_n(r, r, a, m);
+        limb_kernels::add_1(r + m, r + m, n - m, carry);
+    }
+
+    void multiply_schoolbook(uint64_t* r, const uint64_t* a, const size_t an, const uint64_t* b, const size_t bn)
+    {
+        for (size_t i = 0; i < bn; ++i)
+        {
+            r[i + an] = limb_kernels::addmul_1(r + i, a, an, b[i]);
+        }
+    }
 
-    for (size_t i = 0; i < a.size(); ++i)
+    // Unbalanced operands: multiply bn-limb slices of a by b and accumulate them
+    void multiply_sliced(uint64_t* r, const uint64_t* a, const size_t an, const uint64_t* b, const size_t bn)
     {
-        uint128_t diff = static_cast<uint128_t>(a[i]) - borrow;
-        if (i < b.size()) diff -= b[i];
+        std::vector<uint64_t> slice(2 * bn);
+        for (size_t offset = 0; offset < an; offset += bn)
+        {
+            const size_t length = std::min(bn, an - offset);
+            std::fill(slice.begin(), slice.end(), 0);
+            if (length >= bn)
+            {
+                multiply_limbs(slice.data(), a + offset, length, b, bn);
+            }
+            else
+            {
+                multiply_limbs(slice.data(), b, bn, a + offset, length);
+            }
+            add_into(r + offset, an + bn - offset, slice.data(), length + bn);
+        }
+    }
 
-        if (diff > UINT64_MAX)
+    // a = a1 B^m + a0, b = b1 B^m + b0:
+    // a b = a1 b1 B^2m + ((a0 + a1)(b0 + b1) - a0 b0 - a1 b1) B^m + a0 b0
+    void multiply_karatsuba(uint64_t* r, const uint64_t* a, const size_t an, const uint64_t* b, const size_t bn)
+    {
+        const size_t m = (an + 1) / 2;
+        const size_t n = an + bn;
+
+        std::vector<uint64_t> a_sum(m + 1);
+        std::vector<uint64_t> b_sum(m + 1);
+        uint64_t carry = limb_kernels::add_n(a_sum.data(), a, a + m, an - m);
+        a_sum[m] = limb_kernels::add_1(a_sum.data() + an - m, a + an - m, 2 * m - an, carry);
+        carry = limb_kernels::add_n(b_sum.data(), b, b + m, bn - m);
+        b_sum[m] = limb_kernels::add_1(b_sum.data() + bn - m, b + bn - m, 2 * m - bn, carry);
+
+        // The three half-size products write disjoint outputs, so large ones run in parallel
+        std::vector<uint64_t> middle(2 * m + 2);
+        std::vector<std::function<void()>> products{
+            [&] { multiply_limbs(r, a, m, b, m); },
+            [&] { multiply_limbs(r + 2 * m, a + m, an - m, b + m, bn - m); },
+            [&] { multiply_limbs(middle.data(), a_sum.data(), m + 1, b_sum.data(), m + 1); },
+        };
+        if (bn >= PARALLEL_THRESHOLD && ThreadPool::instance().size() > 1)
         {
-            borrow = 1;
-            diff += static_cast<uint128_t>(1) << 64;
+            ThreadPool::instance().run_all(products);
         }
         else
         {
-            borrow = 0;
+            for (const auto& product : products)
+            {
+                product();
+            }
         }
+        uint64_t borrow = limb_kernels::sub_n(middle.data(), middle.data(), r, 2 * m);
+        limb_kernels::sub_1(middle.data() + 2 * m, middle.data() + 2 * m, 2, borrow);
+        borrow = limb_kernels::sub_n(middle.data(), middle.data(), r + 2 * m, n - 2 * m);
+        limb_kernels::sub_1(middle.data() + n - 2 * m, middle.data() + n - 2 * m, 4 * m + 2 - n, borrow);
 
-        result[i] = static_cast<uint64_t>(diff);
+        // The middle term is at most a b / B^m, so its limbs above n - m are zero
+        add_into(r + m, n - m, middle.data(), std::min(middle.size(), n - m));
     }
 
-    return UBigInt(result);
+    void multiply_limbs(uint64_t* r, const uint64_t* a, const size_t an, const uint64_t* b, const size_t bn)
+    {
+        if (bn < KARATSUBA_THRESHOLD)
+        {
+            multiply_schoolbook(r, a, an, b, bn);
+        }
+        else if (bn <= (an + 1) / 2)
+        {
+            multiply_sliced(r, a, an, b, bn);
+        }
+        else
+        {
+            multiply_karatsuba(r, a, an, b, bn);
+        }
+    }
 }
 
 UBigInt UBigInt::operator*(const UBigInt& other) const
@@ -350,27 +427,13 @@ UBigInt UBigInt::operator*(const UBigInt& other) const
         return UBigInt(0);
     }
 
-    const auto& a = data;
-    const auto& b = other.data;
+    // The longer operand drives the inner kernel loop
+    const auto& a = data.size() >= other.data.size() ? data : other.data;
+    const auto& b = data.size() >= other.data.size() ? other.data : data;
     std::vector<uint64_t> result(a.size() + b.size(), 0);
+    multiply_limbs(result.data(), a.data(), a.size(), b.data(), b.size());
 
-    for (size_t i = 0; i < a.size(); ++i)
-    {
-        uint128_t carry = 0;
-        for (size_t j = 0; j < b.size(); ++j)
-        {
-            const uint128_t product = static_cast<uint128_t>(a[i]) * b[j] +
-                result[i + j] + carry;
-            result[i + j] = static_cast<uint64_t>(product);
-            carry = product >> 64;
-        }
-        if (carry)
-        {
-            result[i + b.size()] = static_cast<uint64_t>(carry);
-        }
-    }
-
-    return UBigInt(result);
+    return UBigInt(std::move(result));
 }
 
 std::pair<UBigInt, UBigInt> UBigInt::divide(const UBigInt& divisor) const
@@ -403,6 +466,20 @@ UBigInt UBigInt::operator%(const UBigInt& other) const
     return divide(other).second;
 }
 
+UBigInt UBigInt::operator<<(const size_t bits) const
+{
+    UBigInt result = *this;
+    result.shift_left(bits);
+    return result;
+}
+
+UBigInt UBigInt::operator>>(const size_t bits) const
+{
+    UBigInt result = *this;
+    result.shift_right(bits);
+    return result;
+}
+
 // Fast exponentiation by squaring
 UBigInt UBigInt::pow(const UBigInt& exponent) const
 {
@@ -528,78 +605,645 @@ std::string UBigInt::to_hex_string() const
         return {UBigInt(1), UBigInt(0)};
     }
 
-    // Normalize by shifting to make the divisor's MSB set
-    int shift = 0;
-    uint64_t divisor_msb = divisor.data.back();
-    while ((divisor_msb & (static_cast<uint64_t>(1) << 63)) == 0)
+    // Knuth 4.3.1, Algorithm D: normalize so the divisor's MSB is set, then estimate each
+    // quotient limb from the top two limbs and correct it with a single multiply-subtract pass
+    const size_t n = divisor.data.size();
+    const size_t m = data.size() - n;
+    const int shift = std::countl_zero(divisor.data.back());
+
+    std::vector<uint64_t> v(n);
+    std::vector<uint64_t> u(data.size() + 1);
+    for (size_t i = n; i-- > 0;)
     {
-        divisor_msb <<= 1;
-        shift++;
+        v[i] = divisor.data[i] << shift;
+        if (shift > 0 && i > 0) v[i] |= divisor.data[i - 1] >> (64 - shift);
     }
-
-    UBigInt dividend(*this);
-    UBigInt normalized_divisor(divisor);
-
-    if (shift > 0)
+    u[data.size()] = shift > 0 ? data.back() >> (64 - shift) : 0;
+    for (size_t i = data.size(); i-- > 0;)
     {
-        dividend.shift_left(shift);
-        normalized_divisor.shift_left(shift);
+        u[i] = data[i] << shift;
+        if (shift > 0 && i > 0) u[i] |= data[i - 1] >> (64 - shift);
     }
 
-    const size_t n = normalized_divisor.data.size();
-    const size_t m = dividend.data.size() - n;
-
     UBigInt quotient(0);
-    quotient.data.resize(m + 1, 0);
+    quotient.data.assign(m + 1, 0);
 
-    // Precompute helper values
-    const uint64_t divisor_high = normalized_divisor.data[n - 1];
-    const uint64_t divisor_high_minus_1 = n > 1 ? normalized_divisor.data[n - 2] : 0;
+    const uint64_t divisor_high = v[n - 1];
+    const uint64_t divisor_next = n > 1 ? v[n - 2] : 0;
 
-    for (size_t j = m; j < m + 1; --j)
+    for (size_t j = m + 1; j-- > 0;)
     {
         // Estimate quotient digit
-        const uint64_t dividend_high = j + n < dividend.data.size() ? dividend.data[j + n] : 0;
-        const uint64_t dividend_mid = j + n - 1 < dividend.data.size() ? dividend.data[j + n - 1] : 0;
-        const uint64_t dividend_low = j + n - 2 < dividend.data.size() ? dividend.data[j + n - 2] : 0;
-
-        const uint128_t value_high = static_cast<uint128_t>(dividend_high) << 64 | dividend_mid;
-        auto q_hat = static_cast<uint64_t>(value_high / divisor_high);
-        auto r_hat = static_cast<uint64_t>(value_high % divisor_high);
+        const uint128_t numerator = static_cast<uint128_t>(u[j + n]) << 64 | u[j + n - 1];
+        uint128_t q_hat = numerator / divisor_high;
+        uint128_t r_hat = numerator % divisor_high;
 
-        // Refine quotient estimate
-        while (q_hat > UINT64_MAX / divisor_high_minus_1 ||
-            (q_hat * divisor_high_minus_1 > ((static_cast<uint128_t>(r_hat) << 64) | dividend_low)))
+        // Refine quotient estimate, at most two corrections are needed
+        while (q_hat >> 64 || q_hat * divisor_next > (r_hat << 64 | (j + n >= 2 ? u[j + n - 2] : 0)))
         {
             q_hat--;
             r_hat += divisor_high;
-            if (r_hat < divisor_high) break; // overflow check
+            if (r_hat >> 64) break;
         }
 
         // Multiply and subtract
-        UBigInt product = normalized_divisor * UBigInt(q_hat);
-        product.shift_left(j * 64);
+        const uint64_t borrow = limb_kernels::submul_1(u.data() + j, v.data(), n, static_cast<uint64_t>(q_hat));
+        const bool negative = u[j + n] < borrow;
+        u[j + n] -= borrow;
 
-        if (dividend < product)
+        if (negative)
         {
+            // Estimate was one too large: add the divisor back
             q_hat--;
-            product = normalized_divisor * UBigInt(q_hat);
-            product.shift_left(j * 64);
+            u[j + n] += limb_kernels::add_n(u.data() + j, u.data() + j, v.data(), n);
         }
-
-        dividend = dividend - product;
-        quotient.data[j] = q_hat;
+        quotient.data[j] = static_cast<uint64_t>(q_hat);
     }
 
     quotient.normalize();
 
     // Denormalize remainder
-    if (shift > 0)
+    UBigInt remainder(0);
+    remainder.data.assign(n, 0);
+    for (size_t i = 0; i < n; ++i)
+    {
+        remainder.data[i] = u[i] >> shift;
+        if (shift > 0) remainder.data[i] |= u[i + 1] << (64 - shift);
+    }
+    remainder.normalize();
+
+    return {quotient, remainder};
+}
+
+uint64_t UBigInt::gcd_word(uint64_t a, uint64_t b)
+{
+    // Binary (Stein's) GCD: shifts and subtractions only, no hardware division
+    if (a == 0) return b;
+    if (b == 0) return a;
+    const int shift = std::countr_zero(a | b);
+    a >>= std::countr_zero(a);
+    do
+    {
+        b >>= std::countr_zero(b);
+        if (a > b) std::swap(a, b);
+        b -= a;
+    }
+    while (b != 0);
+    return a << shift;
+}
+
+// Bits [shift, shift + 64) of the limb vector
+static uint64_t extract_word(const std::vector<uint64_t>& limbs, const size_t shift)
+{
+    const size_t word = shift / 64;
+    const size_t bit = shift % 64;
+    uint64_t result = word < limbs.size() ? limbs[word] >> bit : 0;
+    if (bit > 0 && word + 1 < limbs.size())
+    {
+        result |= limbs[word + 1] << (64 - bit);
+    }
+    return result;
+}
+
+// x * a + y * b for cofactors of opposite sign, where the result is known to be non-negative.
+// Cofactors stay below 2^62, so each column fits comfortably in a signed 128-bit accumulator.
+static std::vector<uint64_t> lehmer_combine(const std::vector<uint64_t>& a, const std::vector<uint64_t>& b,
+                                            const int64_t x, const int64_t y)
+{
+    const size_t n = std::max(a.size(), b.size());
+    std::vector<uint64_t> result(n + 1, 0);
+    int128_t carry = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        int128_t column = carry;
+        if (i < a.size()) column += static_cast<int128_t>(x) * a[i];
+        if (i < b.size()) column += static_cast<int128_t>(y) * b[i];
+        result[i] = static_cast<uint64_t>(column);
+        carry = column >> 64;
+    }
+    result[n] = static_cast<uint64_t>(carry);
+    return result;
+}
+
+UBigInt UBigInt::gcd(UBigInt a, UBigInt b)
+{
+    if (a < b) std::swap(a, b);
+
+    // Lehmer's algorithm (Knuth 4.5.2, Algorithm L): run Euclid on the leading 62 bits and
+    // apply the accumulated cofactors to the full numbers in one linear pass, instead of a
+    // multi-precision division per quotient digit.
+    while (b.data.size() > 1)
+    {
+        const size_t shift = a.bit_length() - 62;
+        int128_t x = extract_word(a.data, shift);
+        int128_t y = extract_word(b.data, shift);
+        int128_t A = 1, B = 0, C = 0, D = 1;
+        while (y + C > 0 && y + D > 0)
+        {
+            const int128_t q = (x + A) / (y + C);
+            if (q != (x + B) / (y + D)) break;
+            int128_t t = A - q * C;
+            A = C;
+            C = t;
+            t = B - q * D;
+            B = D;
+            D = t;
+            t = x - q * y;
+            x = y;
+            y = t;
+        }
+        if (B == 0)
+        {
+            // The leading digits disagree on the very first quotient: take one full step
+            UBigInt r = a % b;
+            a = std::move(b);
+            b = std::move(r);
+            continue;
+        }
+        UBigInt next_a(lehmer_combine(a.data, b.data, static_cast<int64_t>(A), static_cast<int64_t>(B)));
+        UBigInt next_b(lehmer_combine(a.data, b.data, static_cast<int64_t>(C), static_cast<int64_t>(D)));
+        a = std::move(next_a);
+        b = std::move(next_b);
+    }
+
+    if (b.is_zero())
+    {
+        return a;
+    }
+    const uint64_t divisor = b.data[0];
+    const uint64_t remainder = a.data.size() == 1 ? a.data[0] % divisor : a.divide_single_word(divisor).second.data[0];
+    return UBigInt(gcd_word(divisor, remainder));
+}
+
+uint64_t UBigInt::isqrt_word(const uint64_t n)
+{
+    auto root = static_cast<uint64_t>(std::sqrt(static_cast<double>(n)));
+    // The double estimate is off by at most one in either direction
+    while (static_cast<uint128_t>(root) * root > n) root--;
+    while (static_cast<uint128_t>(root + 1) * (root + 1) <= n) root++;
+    return root;
+}
+
+UBigInt UBigInt::isqrt(const UBigInt& n)
+{
+    if (n.data.size() == 1)
+    {
+        return UBigInt(isqrt_word(n.data[0]));
+    }
+
+    // Seed with sqrt(top + 1) * 2^(shift / 2) rounded up, where top holds the leading (at most
+    // 104) bits: it bounds the root from above, so Newton descends monotonically and each step
+    // doubles the correct bits of the 52-bit estimate.
+    const size_t bits = n.bit_length();
+    size_t shift = bits > 104 ? bits - 104 : 0;
+    shift += shift & 1;
+    UBigInt top = n;
+    top.shift_right(shift);
+    const double top_value = std::ldexp(static_cast<double>(top.data.size() > 1 ? top.data[1] : 0), 64) +
+                             static_cast<double>(top.data[0]);
+    UBigInt x(static_cast<uint64_t>(std::sqrt(top_value + 1)) + 2);
+    x.shift_left(shift / 2);
+
+    while (true)
+    {
+        UBigInt y = x + n / x;
+        y.shift_right(1);
+        if (y >= x)
+        {
+            return x;
+        }
+        x = std::move(y);
+    }
+}
+
+UBigInt UBigInt::iroot(const UBigInt& n, const uint64_t k)
+{
+    if (k == 0)
+    {
+        throw std::domain_error("Zeroth root is undefined");
+    }
+    if (k == 1 || n.is_zero() || n.is_one())
+    {
+        return n;
+    }
+    if (k == 2)
+    {
+        return isqrt(n);
+    }
+    const size_t bits = n.bit_length();
+    if (k >= bits)
+    {
+        // n < 2^k
+        return UBigInt(1);
+    }
+
+    // Floating seed 2^(log2(n) / k) from the leading 64 bits
+    UBigInt top = n;
+    const size_t top_shift = bits > 64 ? bits - 64 : 0;
+    top.shift_right(top_shift);
+    const double root_log = (static_cast<double>(top_shift) + std::log2(static_cast<double>(top.data[0]))) /
+                            static_cast<double>(k);
+    UBigInt x(0);
+    if (root_log < 62)
+    {
+        x = UBigInt(static_cast<uint64_t>(std::exp2(root_log)) + 1);
+    }
+    else
+    {
+        const auto exponent = static_cast<size_t>(root_log) - 52;
+        x = UBigInt(static_cast<uint64_t>(std::exp2(root_log - static_cast<double>(exponent))) + 1);
+        x.shift_left(exponent);
+    }
+
+    // One unconditional step lands on or above the root (AM-GM), from there Newton descends
+    const UBigInt k_big(k);
+    const UBigInt k_minus_one(k - 1);
+    x = (k_minus_one * x + n / x.pow(k_minus_one)) / k_big;
+    while (true)
+    {
+        UBigInt y = (k_minus_one * x + n / x.pow(k_minus_one)) / k_big;
+        if (y >= x)
+        {
+            return x;
+        }
+        x = std::move(y);
+    }
+}
+
+bool UBigInt::maybe_square(const UBigInt& n)
+{
+    // Squares modulo 64, 63, 65 and 11 (Cohen 1.7.1): together they reject all but ~0.6% of
+    // non-squares for the cost of a single pass over the limbs.
+    static const auto residues = []
+    {
+        std::array<std::array<bool, 65>, 4> table{};
+        constexpr std::array<uint64_t, 4> moduli = {64, 63, 65, 11};
+        for (size_t m = 0; m < moduli.size(); ++m)
+        {
+            for (uint64_t i = 0; i < moduli[m]; ++i)
+            {
+                table[m][i * i % moduli[m]] = true;
+            }
+        }
+        return table;
+    }();
+    if (!residues[0][n.data[0] & 63])
+    {
+        return false;
+    }
+    constexpr uint64_t combined = 63 * 65 * 11;
+    uint64_t mod = 0;
+    for (size_t i = n.data.size(); i-- > 0;)
+    {
+        mod = static_cast<uint64_t>((static_cast<uint128_t>(mod) << 64 | n.data[i]) % combined);
+    }
+    return residues[1][mod % 63] && residues[2][mod % 65] && residues[3][mod % 11];
+}
+
+namespace
+{
+    // Residues modulo an odd n in Montgomery form (x * 2^(64 s) mod n), multiplied with the
+    // CIOS method (Koc et al.) so every product is reduced without any division. Both
+    // multiply-accumulate passes run on the limb_kernels addmul_1 carry chains.
+    class Montgomery
+    {
+        std::vector<uint64_t> n;
+        uint64_t n_prime;
+        std::vector<uint64_t> scratch;
+
+    public:
+        explicit Montgomery(const std::vector<uint64_t>& modulus) : n(modulus), scratch(modulus.size() + 2)
+        {
+            // -n^-1 mod 2^64 by Newton's iteration, each step doubles the correct low bits
+            uint64_t inverse = n[0];
+            for (int i = 0; i < 6; ++i)
+            {
+                inverse *= 2 - n[0] * inverse;
+            }
+            n_prime = -inverse;
+        }
+
+        [[nodiscard]] size_t size() const { return n.size(); }
+
+        void multiply(const std::vector<uint64_t>& a, const std::vector<uint64_t>& b, std::vector<uint64_t>& out)
+        {
+            const size_t s = n.size();
+            std::ranges::fill(scratch, 0);
+            for (size_t i = 0; i < s; ++i)
+            {
+                // scratch stays below 2n, so scratch + a * b[i] + m * n fits in s + 2 limbs
+                uint64_t carry = limb_kernels::addmul_1(scratch.data(), a.data(), s, b[i]);
+                scratch[s + 1] = limb_kernels::add_1(&scratch[s], &scratch[s], 1, carry);
+
+                // m is chosen so that adding m * n clears the low limb, which is then shifted out
+                const uint64_t m = scratch[0] * n_prime;
+                carry = limb_kernels::addmul_1(scratch.data(), n.data(), s, m);
+                scratch[s + 1] += limb_kernels::add_1(&scratch[s], &scratch[s], 1, carry);
+                std::copy(scratch.begin() + 1, scratch.end(), scratch.begin());
+                scratch[s + 1] = 0;
+            }
+
+            // The result is below 2n: one conditional subtraction brings it into [0, n)
+            bool subtract = scratch[s] != 0;
+            if (!subtract)
+            {
+                subtract = true;
+                for (size_t j = s; j-- > 0;)
+                {
+                    if (scratch[j] != n[j])
+                    {
+                        subtract = scratch[j] > n[j];
+                        break;
+                    }
+                }
+            }
+            out.resize(s);
+            if (subtract)
+            {
+                limb_kernels::sub_n(out.data(), scratch.data(), n.data(), s);
+            }
+            else
+            {
+                std::copy_n(scratch.begin(), s, out.begin());
+            }
+        }
+    };
+
+    bool exponent_bit(const std::vector<uint64_t>& exponent, const size_t index)
+    {
+        return exponent[index / 64] >> (index % 64) & 1;
+    }
+
+    // Left-to-right sliding window over the exponent bits: squarings for every bit, but only
+    // one multiplication per window of up to `width` bits, by a precomputed odd power.
+    template <typename Value, typename Multiply>
+    Value sliding_window_pow(const Value& base, const Value& one, const UBigInt& exponent, Multiply multiply)
+    {
+        const size_t bits = exponent.bit_length();
+        const size_t width = bits <= 24 ? 1 : bits <= 80 ? 3 : bits <= 240 ? 4 : bits <= 672 ? 5 : 6;
+        const auto& limbs = exponent.get_data();
+
+        // odd_powers[i] = base^(2i + 1)
+        std::vector<Value> odd_powers(size_t{1} << (width - 1));
+        odd_powers[0] = base;
+        if (width > 1)
+        {
+            Value square = multiply(base, base);
+            for (size_t i = 1; i < odd_powers.size(); ++i)
+            {
+                odd_powers[i] = multiply(odd_powers[i - 1], square);
+            }
+        }
+
+        Value result = one;
+        size_t index = bits;
+        while (index > 0)
+        {
+            if (!exponent_bit(limbs, index - 1))
+            {
+                result = multiply(result, result);
+                index--;
+                continue;
+            }
+            // Longest window [low, index) of at most `width` bits that ends in a set bit
+            size_t low = index > width ? index - width : 0;
+            while (!exponent_bit(limbs, low)) low++;
+            size_t window = 0;
+            for (size_t i = index; i-- > low;)
+            {
+                result = multiply(result, result);
+                window = window << 1 | exponent_bit(limbs, i);
+            }
+            result = multiply(result, odd_powers[window >> 1]);
+            index = low;
+        }
+        return result;
+    }
+}
+
+UBigInt UBigInt::expt_mod(const UBigInt& base, const UBigInt& exponent, const UBigInt& modulus)
+{
+    if (modulus.is_zero())
+    {
+        throw std::domain_error("Modulus must be nonzero");
+    }
+    if (modulus.is_one())
+    {
+        return UBigInt(0);
+    }
+    if (exponent.is_zero())
+    {
+        return UBigInt(1);
+    }
+    UBigInt reduced = base % modulus;
+
+    if ((modulus.data[0] & 1) == 0)
     {
-        dividend.shift_right(shift);
+        // Even moduli have no Montgomery form: reduce each product by long division
+        return sliding_window_pow(reduced, UBigInt(1), exponent,
+                                  [&modulus](const UBigInt& a, const UBigInt& b) { return a * b % modulus; });
     }
 
-    return {quotient, dividend};
+    Montgomery montgomery(modulus.data);
+    const size_t s = montgomery.size();
+    const auto to_montgomery = [&](UBigInt value)
+    {
+        value.shift_left(64 * s);
+        std::vector<uint64_t> limbs = (value % modulus).data;
+        limbs.resize(s, 0);
+        return limbs;
+    };
+    const auto one = to_montgomery(UBigInt(1));
+    const auto result = sliding_window_pow(to_montgomery(std::move(reduced)), one, exponent,
+                                           [&montgomery](const std::vector<uint64_t>& a, const std::vector<uint64_t>& b)
+                                           {
+                                               std::vector<uint64_t> product;
+                                               montgomery.multiply(a, b, product);
+                                               return product;
+                                           });
+    // Leave Montgomery form by multiplying with a plain 1
+    std::vector<uint64_t> plain_one(s, 0);
+    plain_one[0] = 1;
+    std::vector<uint64_t> plain;
+    montgomery.multiply(result, plain_one, plain);
+    return UBigInt(std::move(plain));
+}
+
+namespace
+{
+    // Product of words[lo, hi) by balanced halving, so both operands of the large
+    // multiplications near the root have similar size
+    UBigInt word_product(const std::vector<uint64_t>& words, const size_t lo, const size_t hi)
+    {
+        if (hi - lo == 1)
+        {
+            return UBigInt(words[lo]);
+        }
+        const size_t mid = lo + (hi - lo) / 2;
+        return word_product(words, lo, mid) * word_product(words, mid, hi);
+    }
+
+    // Collects factors into words, multiplying small factors together while they fit
+    class WordPacker
+    {
+        std::vector<uint64_t> words;
+        uint64_t current = 1;
+
+    public:
+        void push(const uint64_t factor)
+        {
+            if (uint64_t packed; !__builtin_mul_overflow(current, factor, &packed))
+            {
+                current = packed;
+                return;
+            }
+            words.push_back(current);
+            current = factor;
+        }
+
+        UBigInt product()
+        {
+            if (current != 1 || words.empty())
+            {
+                words.push_back(current);
+            }
+            return word_product(words, 0, words.size());
+        }
+    };
+
+    // Odd-only sieve of Eratosthenes, returning the primes up to n
+    std::vector<uint64_t> primes_up_to(const uint64_t n)
+    {
+        std::vector<uint64_t> primes;
+        if (n < 2)
+        {
+            return primes;
+        }
+        primes.push_back(2);
+        std::vector<bool> composite((n - 1) / 2, false);
+        for (uint64_t i = 0; i < composite.size(); ++i)
+        {
+            if (composite[i])
+            {
+                continue;
+            }
+            const uint64_t p = 2 * i + 3;
+            primes.push_back(p);
+            for (uint64_t j = (p * p - 3) / 2; j < composite.size(); j += p)
+            {
+                composite[j] = true;
+            }
+        }
+        return primes;
+    }
+
+    constexpr uint64_t SMALL_FACTORIAL_LIMIT = 20;
+
+    // The swing factorial n! / (n/2)!^2: a prime p appears once for every odd quotient n / p^i
+    UBigInt swing(const uint64_t n, const std::vector<uint64_t>& primes)
+    {
+        WordPacker packer;
+        for (const uint64_t p : primes)
+        {
+            if (p > n)
+            {
+                break;
+            }
+            for (uint64_t q = n / p; q > 0; q /= p)
+            {
+                if (q & 1)
+                {
+                    packer.push(p);
+                }
+            }
+        }
+        return packer.product();
+    }
+
+    UBigInt prime_swing_factorial(const uint64_t n, const std::vector<uint64_t>& primes)
+    {
+        if (n <= SMALL_FACTORIAL_LIMIT)
+        {
+            uint64_t result = 1;
+            for (uint64_t i = 2; i <= n; ++i)
+            {
+                result *= i;
+            }
+            return UBigInt(result);
+        }
+        const UBigInt half = prime_swing_factorial(n / 2, primes);
+        return half * half * swing(n, primes);
+    }
+
+    // Sieving beyond this bound costs more than it saves, binomial falls back to a falling product
+    constexpr uint64_t BINOMIAL_SIEVE_LIMIT = 1ULL << 26;
+}
+
+UBigInt UBigInt::product(const std::vector<UBigInt>& factors)
+{
+    if (factors.empty())
+    {
+        return UBigInt(1);
+    }
+    std::vector<UBigInt> level = factors;
+    while (level.size() > 1)
+    {
+        std::vector<UBigInt> next;
+        next.reserve((level.size() + 1) / 2);
+        for (size_t i = 0; i + 1 < level.size(); i += 2)
+        {
+            next.push_back(level[i] * level[i + 1]);
+        }
+        if (level.size() % 2 == 1)
+        {
+            next.push_back(std::move(level.back()));
+        }
+        level = std::move(next);
+    }
+    return std::move(level.front());
+}
+
+UBigInt UBigInt::factorial(const uint64_t n)
+{
+    if (n <= SMALL_FACTORIAL_LIMIT)
+    {
+        return prime_swing_factorial(n, {});
+    }
+    return prime_swing_factorial(n, primes_up_to(n));
+}
+
+UBigInt UBigInt::binomial(const uint64_t n, uint64_t k)
+{
+    if (k > n)
+    {
+        return UBigInt(0);
+    }
+    k = std::min(k, n - k);
+    if (n > BINOMIAL_SIEVE_LIMIT)
+    {
+        // n (n-1) ... (n-k+1) / k!, exact division
+        WordPacker packer;
+        for (uint64_t i = 0; i < k; ++i)
+        {
+            packer.push(n - i);
+        }
+        return packer.product() / factorial(k);
+    }
+    // Kummer: the exponent of p in C(n, k) is the number of borrows subtracting k from n in base p
+    WordPacker packer;
+    for (const uint64_t p : primes_up_to(n))
+    {
+        uint64_t borrow = 0;
+        for (uint64_t a = n, b = k; a > 0; a /= p, b /= p)
+        {
+            borrow = a % p < b % p + borrow ? 1 : 0;
+            if (borrow)
+            {
+                packer.push(p);
+            }
+        }
+    }
+    return packer.product();
 }
 
 UBigInt UBigInt::from_decimal_string(const std::string& str)
@@ -612,6 +1256,187 @@ std::string UBigInt::to_decimal_string() const
     return DecimalConverter::to_string(*this);
 }
 
+namespace
+{
+    constexpr int REAL_DIGITS = std::numeric_limits<real>::digits;
+
+    // The value (m + sticky * epsilon) * 2^exponent rounded half-to-even to the precision of
+    // real. The precision shrinks in the subnormal range so that the result is rounded once.
+    real round_to_real(uint128_t m, const bool sticky, int64_t exponent)
+    {
+        if (m == 0)
+        {
+            return 0;
+        }
+        const int64_t bits = 128 - (m >> 64 ? std::countl_zero(static_cast<uint64_t>(m >> 64))
+                                            : 64 + std::countl_zero(static_cast<uint64_t>(m)));
+        const int64_t top = exponent + bits - 1;
+        constexpr int64_t min_top = std::numeric_limits<real>::min_exponent - 1;
+        const int64_t precision = top >= min_top ? REAL_DIGITS : REAL_DIGITS - (min_top - top);
+        if (const int64_t drop = bits - precision; drop > 0)
+        {
+            if (drop > bits)
+            {
+                // Below half of the smallest subnormal
+                return 0;
+            }
+            const bool guard = (m >> (drop - 1)) & 1;
+            const bool lower = sticky || (drop > 1 && (m & ((static_cast<uint128_t>(1) << (drop - 1)) - 1)) != 0);
+            m = drop < 128 ? m >> drop : 0;
+            if (guard && (lower || (m & 1)))
+            {
+                ++m;
+            }
+            exponent += drop;
+        }
+        // m now has at most precision + 1 bits, so the conversion and scaling are exact
+        return std::ldexp(static_cast<real>(m), static_cast<int>(std::clamp<int64_t>(exponent, INT32_MIN, INT32_MAX)));
+    }
+
+    // Bits [shift, shift + 128) of the limbs
+    uint128_t bits_from(const std::vector<uint64_t>& limbs, const size_t shift)
+    {
+        const size_t word = shift / 64;
+        const size_t offset = shift % 64;
+        uint128_t result = 0;
+        for (size_t i = 0; i < 3 && word + i < limbs.size(); ++i)
+        {
+            const uint128_t limb = limbs[word + i];
+            if (i == 0)
+            {
+                result = limb >> offset;
+            }
+            else if (64 * i - offset < 128)
+            {
+                result |= limb << (64 * i - offset);
+            }
+        }
+        return result;
+    }
+
+    bool any_bits_below(const std::vector<uint64_t>& limbs, const size_t shift)
+    {
+        const size_t word = shift / 64;
+        for (size_t i = 0; i < word && i < limbs.size(); ++i)
+        {
+            if (limbs[i] != 0)
+            {
+                return true;
+            }
+        }
+        return word < limbs.size() && shift % 64 != 0 && (limbs[word] & ((1ULL << (shift % 64)) - 1)) != 0;
+    }
+}
+
+real UBigInt::to_real() const
+{
+    // Only the leading REAL_DIGITS + 2 bits and a sticky bit for the rest decide the rounding
+    const size_t bits = bit_length();
+    const size_t shift = bits > REAL_DIGITS + 2 ? bits - (REAL_DIGITS + 2) : 0;
+    return round_to_real(bits_from(data, shift), any_bits_below(data, shift), static_cast<int64_t>(shift));
+}
+
+real UBigInt::ratio_to_real(const UBigInt& num, const UBigInt& den)
+{
+    if (den.is_zero())
+    {
+        throw std::invalid_argument("Division by zero");
+    }
+    if (num.is_zero())
+    {
+        return 0;
+    }
+    // Scale so the quotient carries at least REAL_DIGITS + 2 bits, then let the remainder
+    // act as the sticky bit: one division of about a word's worth of quotient
+    const int64_t scale = static_cast<int64_t>(REAL_DIGITS + 2) -
+                          (static_cast<int64_t>(num.bit_length()) - static_cast<int64_t>(den.bit_length())) + 1;
+    const auto [quotient, remainder] = scale >= 0 ? (num << scale).divide(den) : num.divide(den << -scale);
+    return round_to_real(bits_from(quotient.data, 0), !remainder.is_zero(), -scale);
+}
+
+namespace
+{
+    constexpr char RADIX_DIGITS[] = "0123456789abcdef";
+
+    int digit_value(const char c, const unsigned radix)
+    {
+        int value;
+        if (c >= '0' && c <= '9') value = c - '0';
+        else if (c >= 'a' && c <= 'f') value = c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F') value = c - 'A' + 10;
+        else return -1;
+        return value < static_cast<int>(radix) ? value : -1;
+    }
+
+    void expect_supported_radix(const unsigned radix)
+    {
+        if (radix != 2 && radix != 8 && radix != 10 && radix != 16)
+        {
+            throw std::invalid_argument("Unsupported radix " + std::to_string(radix));
+        }
+    }
+}
+
+std::string UBigInt::to_string(const unsigned radix) const
+{
+    expect_supported_radix(radix);
+    if (radix == 10)
+    {
+        return to_decimal_string();
+    }
+    // Each digit is a fixed group of bits, possibly straddling two limbs
+    const auto bits_per_digit = static_cast<size_t>(std::countr_zero(radix));
+    const size_t digits = (bit_length() + bits_per_digit - 1) / bits_per_digit;
+    std::string result(digits, '0');
+    for (size_t i = 0; i < digits; ++i)
+    {
+        const size_t bit = i * bits_per_digit;
+        const size_t word = bit / 64;
+        const size_t offset = bit % 64;
+        uint64_t group = data[word] >> offset;
+        if (offset + bits_per_digit > 64 && word + 1 < data.size())
+        {
+            group |= data[word + 1] << (64 - offset);
+        }
+        result[digits - 1 - i] = RADIX_DIGITS[group & (radix - 1)];
+    }
+    return result;
+}
+
+std::optional<UBigInt> UBigInt::parse(const std::string_view digits, const unsigned radix)
+{
+    expect_supported_radix(radix);
+    if (digits.empty())
+    {
+        return std::nullopt;
+    }
+    for (const char c : digits)
+    {
+        if (digit_value(c, radix) < 0)
+        {
+            return std::nullopt;
+        }
+    }
+    if (radix == 10)
+    {
+        return DecimalConverter::from_string(std::string(digits));
+    }
+    // Power-of-two radix: every digit lands on a fixed bit position, no multiplication needed
+    const auto bits_per_digit = static_cast<size_t>(std::countr_zero(radix));
+    std::vector<uint64_t> limbs((digits.size() * bits_per_digit + 63) / 64, 0);
+    size_t bit = 0;
+    for (size_t i = digits.size(); i > 0; --i, bit += bits_per_digit)
+    {
+        const auto value = static_cast<uint64_t>(digit_value(digits[i - 1], radix));
+        limbs[bit / 64] |= value << (bit % 64);
+        if (bit % 64 + bits_per_digit > 64)
+        {
+            limbs[bit / 64 + 1] |= value >> (64 - bit % 64);
+        }
+    }
+    return UBigInt(std::move(limbs));
+}
+
 bool UBigInt::operator<(const uint64_t other) const
 {
     if (data.size() > 1) return false;
@@ -720,6 +1545,109 @@ BigInt BigInt::from_decimal_string(const std::string& str)
     return magnitude.is_one();
 }
 
+namespace
+{
+    // The value in `limbs` words of two's complement; the caller leaves room for the sign
+    std::vector<uint64_t> to_twos_complement(const BigInt& value, const size_t limbs)
+    {
+        std::vector<uint64_t> words = value.get_data();
+        words.resize(limbs, 0);
+        if (value.is_negative_sign())
+        {
+            uint64_t carry = 1;
+            for (auto& word : words)
+            {
+                word = ~word + carry;
+                carry = carry && word == 0;
+            }
+        }
+        return words;
+    }
+
+    BigInt from_twos_complement(std::vector<uint64_t> words)
+    {
+        const bool negative = words.back() >> 63;
+        if (negative)
+        {
+            uint64_t carry = 1;
+            for (auto& word : words)
+            {
+                word = ~word + carry;
+                carry = carry && word == 0;
+            }
+        }
+        return BigInt(UBigInt(std::move(words)), negative);
+    }
+
+    template <typename Op>
+    BigInt bitwise_op(const BigInt& a, const BigInt& b, Op op)
+    {
+        // One extra word holds the sign extension of both operands
+        const size_t limbs = std::max(a.get_data().size(), b.get_data().size()) + 1;
+        auto words = to_twos_complement(a, limbs);
+        const auto other = to_twos_complement(b, limbs);
+        for (size_t i = 0; i < limbs; ++i)
+        {
+            words[i] = op(words[i], other[i]);
+        }
+        return from_twos_complement(std::move(words));
+    }
+}
+
+BigInt BigInt::bitwise_and(const BigInt& other) const
+{
+    return bitwise_op(*this, other, [](const uint64_t a, const uint64_t b) { return a & b; });
+}
+
+BigInt BigInt::bitwise_or(const BigInt& other) const
+{
+    return bitwise_op(*this, other, [](const uint64_t a, const uint64_t b) { return a | b; });
+}
+
+BigInt BigInt::bitwise_xor(const BigInt& other) const
+{
+    return bitwise_op(*this, other, [](const uint64_t a, const uint64_t b) { return a ^ b; });
+}
+
+BigInt BigInt::bitwise_not() const
+{
+    // ~n = -n - 1
+    return -*this - BigInt(static_cast<int64_t>(1));
+}
+
+BigInt BigInt::arithmetic_shift(const int64_t shift) const
+{
+    if (shift >= 0)
+    {
+        return BigInt(magnitude << static_cast<size_t>(shift), is_negative);
+    }
+    const size_t bits = static_cast<size_t>(-(shift + 1)) + 1;
+    if (!is_negative)
+    {
+        return BigInt(magnitude >> bits, false);
+    }
+    // Rounds toward negative infinity: -((|n| - 1) >> bits) - 1
+    return BigInt((magnitude - UBigInt(1)) >> bits, true) - BigInt(static_cast<int64_t>(1));
+}
+
+uint64_t BigInt::bit_count() const
+{
+    // The clear bits of a negative n are the set bits of ~n = |n| - 1
+    const UBigInt value = is_negative ? magnitude - UBigInt(1) : magnitude;
+    uint64_t count = 0;
+    for (const uint64_t word : value.get_data())
+    {
+        count += std::popcount(word);
+    }
+    return count;
+}
+
+uint64_t BigInt::integer_length() const
+{
+    const UBigInt value = is_negative ? magnitude - UBigInt(1) : magnitude;
+    return value.is_zero() ? 0 : value.bit_length();
+}
+
 [[nodiscard]] BigInt BigInt::operator-() const
 {
     if (magnitude.is_zero())
@@ -867,5 +1795,6 @@ bool BigInt::operator==(const int64_t other) const
 
 real BigInt::to_real() const
 {
-    return from_string(to_decimal_string());
+    const real value = magnitude.to_real();
+    return is_negative ? -value : value;
 }
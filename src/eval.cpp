@@ -8,49 +8,32 @@
 
 #include "context.h"
 #include "expr.h"
+#include "list_builder.h"
 #include "error.h"
 
 
 shared_ptr<Context> eval_apply_context(const shared_ptr<Context>& ctx, const shared_ptr<Expr>& proc, const shared_ptr<Context>& current_parent, const vector<Param>& params, shared_ptr<Pair>&& args)
 {
     auto context = Context::new_context(current_parent);
-    shared_ptr<Pair> rest = std::move(args);
+    auto rest = args->walk();
     size_t index = 0;
-    while (index != params.size() && !rest->empty())
+    while (index != params.size() && !rest.done())
     {
         const auto& param = params[index];
         const auto& name = param.get_name();
         if (param.is_vararg())
         {
-            shared_ptr<Pair> varargs = nullptr;
-            shared_ptr<Pair> tail = nullptr;
-            for (const auto arg : *rest)
+            ListBuilder varargs;
+            for (; !rest.done(); ++rest)
             {
-                if (!arg) break;
-                auto vararg = eval(ctx, arg);
-                if (!varargs)
-                {
-                    varargs = Pair::single(std::move(vararg));
-                    tail = varargs;
-                }
-                else
-                {
-                    const auto tail_pair = Pair::single(std::move(vararg));
-                    tail->set_cdr(Expr::make_pair(tail_pair));
-                    tail = tail_pair;
-                }
+                varargs.push_back(eval(ctx, *rest));
             }
-            if (!varargs)
-            {
-                varargs = Pair::EMPTY;
-            }
-            context->add(name, Expr::make_pair(std::move(varargs)));
+            context->add(name, varargs.build());
             index = params.size();
             break;
         }
-        const auto arg = eval(ctx, rest->car());
-        rest = rest->cdr()->as_pair();
-        context->add(name, arg);
+        context->add(name, eval(ctx, *rest));
+        ++rest;
         index++;
     }
     if (index != params.size())
@@ -61,6 +44,116 @@ shared_ptr<Context> eval_apply_context(const shared_ptr<Context>& ctx, const sha
     return context;
 }
 
+shared_ptr<Context> bind_arguments(const shared_ptr<Expr>& proc, const shared_ptr<Context>& parent,
+                                   const vector<Param>& params, const std::span<const shared_ptr<Expr>> args)
+{
+    auto context = Context::new_context(parent);
+    for (size_t index = 0; index < params.size(); ++index)
+    {
+        const auto& param = params[index];
+        if (param.is_vararg())
+        {
+            shared_ptr<Expr> varargs = Expr::NIL;
+            for (size_t i = args.size(); i > index; --i)
+            {
+                varargs = Expr::make_pair(Pair::cons(args[i - 1], std::move(varargs)));
+            }
+            context->add(param.get_name(), std::move(varargs));
+            return context;
+        }
+        if (index == args.size())
+        {
+            break;
+        }
+        context->add(param.get_name(), args[index]);
+    }
+    if (params.size() != args.size())
+    {
+        throw GlomError("Incorrect number of arguments provided for " + proc->to_string());
+    }
+    return context;
+}
+
+// Primitives evaluate their own operands, so symbols and lists are passed quoted; every
+// other value evaluates to itself and is passed as is
+shared_ptr<Pair> operands_of(const std::span<const shared_ptr<Expr>> args)
+{
+    // Interned once rather than under the SymbolPool lock on every call
+    static const auto quote = Expr::make_symbol(string("quote"));
+    shared_ptr<Expr> operands = Expr::NIL;
+    for (auto it = args.rbegin(); it != args.rend(); ++it)
+    {
+        auto operand = *it;
+        if (operand->is_symbol() || operand->is_pair())
+        {
+            operand = Expr::make_pair(Pair::cons(quote, Expr::make_pair(Pair::single(std::move(operand)))));
+        }
+        operands = Expr::make_pair(Pair::cons(std::move(operand), std::move(operands)));
+    }
+    return operands->as_pair();
+}
+
+[[noreturn]] void resume_continuation(const shared_ptr<Expr>& proc, const std::span<const shared_ptr<Expr>> args)
+{
+    if (args.size() != 1)
+    {
+        throw GlomError("Continuation requires one argument: " + proc->to_string());
+    }
+    auto& [cont_ctx, cont_exprs, _] = proc->as_cont();
+    throw GlomCont(std::make_unique<Continuation>(cont_ctx, cont_exprs), args.front());
+}
+
+shared_ptr<Expr> apply_procedure(const shared_ptr<Context>& ctx, const shared_ptr<Expr>& proc,
+                                 const std::span<const shared_ptr<Expr>> args)
+{
+    if (proc->is_lambda())
+    {
+        const auto lambda = proc->as_lambda();
+        return eval(bind_arguments(proc, lambda->get_context(), lambda->get_params(), args), lambda->get_body());
+    }
+    if (proc->is_primitive())
+    {
+        auto operands = operands_of(args);
+        auto result = (*proc->as_primitive())(ctx, shared_ptr(operands));
+        if (!result->is_cont())
+        {
+            return result;
+        }
+        auto& [cont_ctx, cont_exprs, callcc] = result->as_cont();
+        if (callcc)
+        {
+            // Capturing the continuation needs the evaluator's own frame
+            return eval(ctx, Expr::make_pair(Pair::cons(proc, Expr::make_pair(std::move(operands)))));
+        }
+        return eval(cont_ctx, cont_exprs);
+    }
+    if (proc->is_cont())
+    {
+        resume_continuation(proc, args);
+    }
+    throw GlomError(proc->to_string() + " is not a procedure");
+}
+
+shared_ptr<Expr> tail_apply_procedure(const shared_ptr<Context>& ctx, const shared_ptr<Expr>& proc,
+                                      const std::span<const shared_ptr<Expr>> args)
+{
+    if (proc->is_lambda())
+    {
+        const auto lambda = proc->as_lambda();
+        return make_continuation(bind_arguments(proc, lambda->get_context(), lambda->get_params(), args),
+                                 lambda->get_body());
+    }
+    if (proc->is_primitive())
+    {
+        return (*proc->as_primitive())(ctx, operands_of(args));
+    }
+    if (proc->is_cont())
+    {
+        resume_continuation(proc, args);
+    }
+    throw GlomError(proc->to_string() + " is not a procedure");
+}
+
 GlomCont::GlomCont(unique_ptr<Continuation> cont, shared_ptr<Expr> value) : cont(std::move(cont)), value(std::move(value)) {}
 
 shared_ptr<Expr> eval(const shared_ptr<Context>& ctx, shared_ptr<Expr> expr)
@@ -114,9 +207,9 @@ shared_ptr<Expr> eval(const shared_ptr<Context>& ctx, shared_ptr<Pair> rest)
             }
             continue;
         }
-        const auto pair = expr->as_pair();
-        const auto proc = eval(current_ctx,std::move(pair->car()));
-        auto args = pair->cdr()->as_pair();
+        const auto& pair = expr->as_pair_ref();
+        const auto proc = eval(current_ctx, pair.car());
+        auto args = pair.cdr()->as_pair();
         if (proc->is_primitive())
         {
             const auto primitive = proc->as_primitive();
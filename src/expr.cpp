@@ -1,3 +1,4 @@
+#include <array>
 #include <utility>
 #include <vector>
 #include <string>
@@ -27,23 +28,42 @@ shared_ptr<Pair> Pair::cons(shared_ptr<Expr> car, shared_ptr<Expr> cdr)
     return std::make_shared<Pair>(Pair(std::move(car), std::move(cdr)));
 }
 
-Pair::iterator::iterator(shared_ptr<Pair> pair): current(std::move(pair)) {}
+namespace
+{
+    const shared_ptr<Expr> EXHAUSTED = nullptr;
+
+    // The pair following pair, or nullptr at the end of its list
+    const Pair* next_pair(const shared_ptr<Expr>& next)
+    {
+        if (!next || !next->is_pair())
+        {
+            return nullptr;
+        }
+        const Pair* pair = &next->as_pair_ref();
+        return pair->empty() ? nullptr : pair;
+    }
+}
 
-shared_ptr<Expr> Pair::iterator::operator*() const
+Pair::iterator::iterator(const Pair* pair): current(pair) {}
+
+const shared_ptr<Expr>& Pair::iterator::operator*() const
 {
-    return current ? current->car() : nullptr;
+    if (tail) {
+        return *tail;
+    }
+    return current ? current->data : EXHAUSTED;
 }
 
 Pair::iterator& Pair::iterator::operator++()
 {
-    if (current && current->cdr()) {
-        if (auto next_expr = current->cdr(); next_expr->is_pair()) {
-            current = next_expr->as_pair();
-        } else {
-            current = single(std::move(next_expr));
+    if (tail) {
+        tail = nullptr;
+    } else if (current) {
+        const auto& next = current->next;
+        current = next_pair(next);
+        if (!current && next && !next->is_pair()) {
+            tail = &next;
         }
-    } else {
-        current = nullptr;
     }
     return *this;
 }
@@ -57,7 +77,7 @@ Pair::iterator Pair::iterator::operator++(int)
 
 bool Pair::iterator::operator==(const iterator& other) const
 {
-    return current == other.current;
+    return current == other.current && tail == other.tail;
 }
 
 bool Pair::iterator::operator!=(const iterator& other) const
@@ -65,6 +85,38 @@ bool Pair::iterator::operator!=(const iterator& other) const
     return !(*this == other);
 }
 
+Pair::cursor::cursor(const Pair* pair): current(pair->empty() ? nullptr : pair), rest(&Expr::NIL) {}
+
+bool Pair::cursor::done() const
+{
+    return !current;
+}
+
+const Pair* Pair::cursor::pair() const
+{
+    return current;
+}
+
+const shared_ptr<Expr>& Pair::cursor::operator*() const
+{
+    return current->data;
+}
+
+Pair::cursor& Pair::cursor::operator++()
+{
+    const auto& next = current->next;
+    current = next_pair(next);
+    if (!current && next) {
+        rest = &next;
+    }
+    return *this;
+}
+
+const shared_ptr<Expr>& Pair::cursor::tail() const
+{
+    return *rest;
+}
+
 shared_ptr<Expr> Pair::car() const
 {
     return data;
@@ -94,25 +146,15 @@ string Pair::to_string() const
     if (empty())
         return "()";
     string result = "(";
-    shared_ptr<Expr> current = data;
-
-    result += current->to_string();
-    current = next;
-
-    while (current && current->is_pair())
+    auto current = walk();
+    result += (*current)->to_string();
+    while (!(++current).done())
     {
-        const auto pair = current->as_pair();
-        if (pair->empty())
-        {
-            current = nullptr;
-            break;
-        }
         result += " ";
-        result += pair->car()->to_string();
-        current = pair->cdr();
+        result += (*current)->to_string();
     }
-    if (current)
-        result += " . " + current->to_string();
+    if (!current.tail()->is_nil())
+        result += " . " + current.tail()->to_string();
     result += ")";
     return result;
 }
@@ -127,6 +169,14 @@ Expr::Expr(rational v) : value(std::make_unique<rational>(std::move(v))) {}
 Expr::Expr(shared_ptr<Pair>&& v) : value(std::move(v)) {}
 Expr::Expr(shared_ptr<Lambda>&& v) : value(std::move(v)) {}
 Expr::Expr(shared_ptr<Primitive>&& v) : value(std::move(v)) {}
+Expr::Expr(shared_ptr<NumVector>&& v) : value(std::move(v)) {}
+Expr::Expr(shared_ptr<Vector>&& v) : value(std::move(v)) {}
+Expr::Expr(shared_ptr<HashTable>&& v) : value(std::move(v)) {}
+Expr::Expr(shared_ptr<const PersistentMap>&& v) : value(std::move(v)) {}
+Expr::Expr(shared_ptr<const PersistentSet>&& v) : value(std::move(v)) {}
+Expr::Expr(shared_ptr<const PVector>&& v) : value(std::move(v)) {}
+Expr::Expr(shared_ptr<const RecordType>&& v) : value(std::move(v)) {}
+Expr::Expr(shared_ptr<Record>&& v) : value(std::move(v)) {}
 Expr::Expr(std::unique_ptr<string>&& v) : value(std::move(v)) {}
 Expr::Expr(std::unique_ptr<Continuation>&& v) : value(std::move(v)) {}
 Expr::Expr(const string_view v): value(v) {}
@@ -149,6 +199,12 @@ bool Expr::is_number_int() const
 {
     return value.index() == NUMBER_INT;
 }
+// An exact integer small enough to stay in an int64, the operand of every fast path
+bool Expr::is_fixnum() const
+{
+    const auto* int_value = std::get_if<integer>(&value);
+    return int_value && int_value->is_int64();
+}
 bool Expr::is_number_rat() const
 {
     return value.index() == NUMBER_RAT;
@@ -185,15 +241,51 @@ bool Expr::is_cont() const
 {
     return value.index() == CONTINUATION;
 }
+bool Expr::is_numvector() const
+{
+    return value.index() == NUMVECTOR;
+}
+bool Expr::is_vector() const
+{
+    return value.index() == VECTOR;
+}
+bool Expr::is_hash_table() const
+{
+    return value.index() == HASH_TABLE;
+}
+bool Expr::is_persistent_map() const
+{
+    return value.index() == PERSISTENT_MAP;
+}
+bool Expr::is_persistent_set() const
+{
+    return value.index() == PERSISTENT_SET;
+}
+bool Expr::is_pvector() const
+{
+    return value.index() == PVECTOR;
+}
+bool Expr::is_record_type() const
+{
+    return value.index() == RECORD_TYPE;
+}
+bool Expr::is_record() const
+{
+    return value.index() == RECORD;
+}
 
 bool Expr::as_boolean() const
 {
     return std::get<bool>(value);
 }
-integer Expr::as_number_int() const
+const integer& Expr::as_number_int() const
 {
     return std::get<integer>(value);
 }
+int64_t Expr::as_fixnum() const
+{
+    return std::get<integer>(value).as_int64();
+}
 const rational& Expr::as_number_rat() const
 {
     return *std::get<unique_ptr<rational>>(value);
@@ -210,10 +302,7 @@ real Expr::to_number_real() const
         case NUMBER_INT:
             return as_number_int().to_real();
         case NUMBER_RAT:
-        {
-            auto& [num, den] = as_number_rat();
-            return num.to_real() / den.to_real();
-        }
+            return as_number_rat().to_inexact();
         case NUMBER_REAL:
             return as_number_real();
         default:
@@ -249,6 +338,10 @@ shared_ptr<Pair> Expr::as_pair() const
 {
     return std::get<shared_ptr<Pair>>(value);
 }
+const Pair& Expr::as_pair_ref() const
+{
+    return *std::get<shared_ptr<Pair>>(value);
+}
 shared_ptr<Lambda> Expr::as_lambda() const
 {
     return std::get<shared_ptr<Lambda>>(value);
@@ -262,6 +355,38 @@ Continuation& Expr::as_cont() const
 {
     return *std::get<std::unique_ptr<Continuation>>(value);
 }
+shared_ptr<NumVector> Expr::as_numvector() const
+{
+    return std::get<shared_ptr<NumVector>>(value);
+}
+shared_ptr<Vector> Expr::as_vector() const
+{
+    return std::get<shared_ptr<Vector>>(value);
+}
+shared_ptr<HashTable> Expr::as_hash_table() const
+{
+    return std::get<shared_ptr<HashTable>>(value);
+}
+const PersistentMap& Expr::as_persistent_map() const
+{
+    return *std::get<shared_ptr<const PersistentMap>>(value);
+}
+const PersistentSet& Expr::as_persistent_set() const
+{
+    return *std::get<shared_ptr<const PersistentSet>>(value);
+}
+const PVector& Expr::as_pvector() const
+{
+    return *std::get<shared_ptr<const PVector>>(value);
+}
+shared_ptr<const RecordType> Expr::as_record_type() const
+{
+    return std::get<shared_ptr<const RecordType>>(value);
+}
+Record& Expr::as_record() const
+{
+    return *std::get<shared_ptr<Record>>(value);
+}
 
 bool Expr::to_boolean() const
 {
@@ -326,6 +451,25 @@ const std::shared_ptr<Expr> Expr::NIL = make_pair(Pair::EMPTY);
 
 shared_ptr<Expr> Expr::make_number_int(integer v)
 {
+    // Counters, indices and loop bounds share preallocated immutable instances
+    constexpr int64_t small_min = -1024;
+    constexpr int64_t small_max = 1024;
+    static const auto small_integers = []
+    {
+        std::array<shared_ptr<Expr>, small_max - small_min + 1> table;
+        for (int64_t i = small_min; i <= small_max; ++i)
+        {
+            table[i - small_min] = std::make_shared<Expr>(Expr(integer(i)));
+        }
+        return table;
+    }();
+    if (v.is_int64())
+    {
+        if (const int64_t n = v.as_int64(); n >= small_min && n <= small_max)
+        {
+            return small_integers[n - small_min];
+        }
+    }
     return std::make_shared<Expr>(Expr(std::move(v)));
 }
 
@@ -375,12 +519,49 @@ shared_ptr<Expr> Expr::make_primitive(shared_ptr<Primitive> v)
 }
 shared_ptr<Expr> Expr::make_pair(shared_ptr<Pair> v)
 {
+    // Every empty list is the NIL singleton (NIL itself is built through here first)
+    if (v == Pair::EMPTY && NIL)
+    {
+        return NIL;
+    }
     return std::make_shared<Expr>(Expr(std::move(v)));
 }
 shared_ptr<Expr> Expr::make_cont(unique_ptr<Continuation> v)
 {
     return std::make_shared<Expr>(Expr(std::move(v)));
 }
+shared_ptr<Expr> Expr::make_numvector(shared_ptr<NumVector> v)
+{
+    return std::make_shared<Expr>(Expr(std::move(v)));
+}
+shared_ptr<Expr> Expr::make_vector(shared_ptr<Vector> v)
+{
+    return std::make_shared<Expr>(Expr(std::move(v)));
+}
+shared_ptr<Expr> Expr::make_hash_table(shared_ptr<HashTable> v)
+{
+    return std::make_shared<Expr>(Expr(std::move(v)));
+}
+shared_ptr<Expr> Expr::make_persistent_map(PersistentMap v)
+{
+    return std::make_shared<Expr>(Expr(std::make_shared<const PersistentMap>(std::move(v))));
+}
+shared_ptr<Expr> Expr::make_persistent_set(PersistentSet v)
+{
+    return std::make_shared<Expr>(Expr(std::make_shared<const PersistentSet>(std::move(v))));
+}
+shared_ptr<Expr> Expr::make_pvector(PVector v)
+{
+    return std::make_shared<Expr>(Expr(std::make_shared<const PVector>(std::move(v))));
+}
+shared_ptr<Expr> Expr::make_record_type(RecordType v)
+{
+    return std::make_shared<Expr>(Expr(std::make_shared<const RecordType>(std::move(v))));
+}
+shared_ptr<Expr> Expr::make_record(Record v)
+{
+    return std::make_shared<Expr>(Expr(std::make_shared<Record>(std::move(v))));
+}
 
 
 shared_ptr<Expr> make_continuation(const shared_ptr<Context>& context, shared_ptr<Pair>&& exprs)
@@ -448,7 +629,7 @@ string Expr::to_string() const
             return as_number_rat().to_rational_string();
         }
         case NUMBER_REAL:
-            return std::to_string(as_number_real());
+            return ::to_string(as_number_real());
         case STRING:
             return as_string();
         case BOOLEAN:
@@ -456,13 +637,66 @@ string Expr::to_string() const
         case SYMBOL:
             return view_to_string(as_symbol());
         case PAIR:
-            return as_pair()->to_string();
+            return as_pair_ref().to_string();
         case LAMBDA:
             return as_lambda()->to_string();
         case PRIMITIVE:
             return "<primitive:" + as_primitive()->get_name() + ">";
         case CONTINUATION:
             return "<continuation>";
+        case NUMVECTOR:
+            return as_numvector()->to_string();
+        case VECTOR:
+        {
+            string result = "#(";
+            const auto& elements = *as_vector();
+            for (size_t i = 0; i < elements.size(); ++i)
+            {
+                if (i > 0)
+                    result += " ";
+                result += elements[i]->to_string();
+            }
+            return result + ")";
+        }
+        case HASH_TABLE:
+            return "<hash-table:" + std::to_string(as_hash_table()->size()) + ">";
+        case PERSISTENT_MAP:
+        {
+            string result = "#hash(";
+            for (const auto& [key, val] : as_persistent_map().entries())
+            {
+                if (result.size() > 6)
+                    result += " ";
+                result += "(" + key->to_string() + " . " + val->to_string() + ")";
+            }
+            return result + ")";
+        }
+        case PERSISTENT_SET:
+        {
+            string result = "#set(";
+            for (const auto& [key, _] : as_persistent_set().entries())
+            {
+                if (result.size() > 5)
+                    result += " ";
+                result += key->to_string();
+            }
+            return result + ")";
+        }
+        case PVECTOR:
+        {
+            string result = "#pvector(";
+            for (const auto& element : as_pvector().elements())
+            {
+                if (result.size() > 9)
+                    result += " ";
+                result += element->to_string();
+            }
+            return result + ")";
+        }
+        case RECORD_TYPE:
+            return "#<record-type " + as_record_type()->get_name() + ">";
+        case RECORD:
+            return as_record().to_string();
         default:
             return "Unknown";
     }
@@ -0,0 +1,344 @@
+//
+// Created by glom on 11/7/25.
+//
+#include "hamt.h"
+
+#include <bit>
+
+#include "expr.h"
+#include "hash_table.h"
+#include "primitive.h"
+
+namespace
+{
+    constexpr unsigned BITS = 5;
+    constexpr unsigned HASH_BITS = 64;
+
+    unsigned fragment(const size_t hash, const unsigned shift)
+    {
+        return static_cast<unsigned>(hash >> shift) & ((1u << BITS) - 1);
+    }
+
+    // Position of the slot for bit among the set bits of map
+    size_t index_of(const uint32_t map, const uint32_t bit)
+    {
+        return static_cast<size_t>(std::popcount(map & (bit - 1)));
+    }
+
+    size_t hash_key(const Expr& key)
+    {
+        return HashTable::hash(HashTable::Equivalence::EQUAL, key);
+    }
+}
+
+struct Hamt::Node
+{
+    struct Leaf
+    {
+        size_t hash;
+        Entry entry;
+    };
+
+    // Slots holding an entry and slots holding a subtree; the two never overlap
+    uint32_t leaf_map = 0;
+    uint32_t child_map = 0;
+    std::vector<Leaf> leaves;
+    std::vector<NodePtr> children;
+    // Below the last level: every leaf has the same hash and the maps are unused
+    bool collision = false;
+
+    [[nodiscard]] const Leaf* find(size_t hash, const std::shared_ptr<Expr>& key, unsigned shift) const;
+    [[nodiscard]] NodePtr assoc(Leaf leaf, unsigned shift, bool& added) const;
+    // nullptr once the node is empty
+    [[nodiscard]] NodePtr dissoc(size_t hash, const std::shared_ptr<Expr>& key, unsigned shift, bool& removed) const;
+    void collect(std::vector<Entry>& out) const;
+    [[nodiscard]] size_t hash_sum() const;
+
+    static bool matches(const Leaf& leaf, size_t hash, const std::shared_ptr<Expr>& key);
+    static NodePtr merge(Leaf first, Leaf second, unsigned shift);
+};
+
+bool Hamt::Node::matches(const Leaf& leaf, const size_t hash, const std::shared_ptr<Expr>& key)
+{
+    return leaf.hash == hash && primitives_utils::is_equal(leaf.entry.first, key);
+}
+
+const Hamt::Node::Leaf* Hamt::Node::find(const size_t hash, const std::shared_ptr<Expr>& key, unsigned shift) const
+{
+    const Node* node = this;
+    while (!node->collision)
+    {
+        const uint32_t bit = 1u << fragment(hash, shift);
+        if (node->leaf_map & bit)
+        {
+            const auto& leaf = node->leaves[index_of(node->leaf_map, bit)];
+            return matches(leaf, hash, key) ? &leaf : nullptr;
+        }
+        if (!(node->child_map & bit))
+        {
+            return nullptr;
+        }
+        node = node->children[index_of(node->child_map, bit)].get();
+        shift += BITS;
+    }
+    for (const auto& leaf : node->leaves)
+    {
+        if (matches(leaf, hash, key))
+        {
+            return &leaf;
+        }
+    }
+    return nullptr;
+}
+
+// The smallest subtree holding two leaves with different keys
+Hamt::NodePtr Hamt::Node::merge(Leaf first, Leaf second, const unsigned shift)
+{
+    auto node = std::make_shared<Node>();
+    if (shift >= HASH_BITS)
+    {
+        node->collision = true;
+        node->leaves = {std::move(first), std::move(second)};
+        return node;
+    }
+    const unsigned first_fragment = fragment(first.hash, shift);
+    const unsigned second_fragment = fragment(second.hash, shift);
+    if (first_fragment == second_fragment)
+    {
+        node->child_map = 1u << first_fragment;
+        node->children.push_back(merge(std::move(first), std::move(second), shift + BITS));
+        return node;
+    }
+    node->leaf_map = (1u << first_fragment) | (1u << second_fragment);
+    if (first_fragment < second_fragment)
+    {
+        node->leaves = {std::move(first), std::move(second)};
+    }
+    else
+    {
+        node->leaves = {std::move(second), std::move(first)};
+    }
+    return node;
+}
+
+Hamt::NodePtr Hamt::Node::assoc(Leaf leaf, const unsigned shift, bool& added) const
+{
+    if (collision)
+    {
+        auto copy = std::make_shared<Node>(*this);
+        for (auto& existing : copy->leaves)
+        {
+            if (matches(existing, leaf.hash, leaf.entry.first))
+            {
+                existing.entry.second = std::move(leaf.entry.second);
+                return copy;
+            }
+        }
+        copy->leaves.push_back(std::move(leaf));
+        added = true;
+        return copy;
+    }
+    const uint32_t bit = 1u << fragment(leaf.hash, shift);
+    if (leaf_map & bit)
+    {
+        const size_t index = index_of(leaf_map, bit);
+        const auto& existing = leaves[index];
+        auto copy = std::make_shared<Node>(*this);
+        if (matches(existing, leaf.hash, leaf.entry.first))
+        {
+            copy->leaves[index].entry.second = std::move(leaf.entry.second);
+            return copy;
+        }
+        // Push both entries one level down
+        auto child = merge(existing, std::move(leaf), shift + BITS);
+        copy->leaves.erase(copy->leaves.begin() + static_cast<ptrdiff_t>(index));
+        copy->leaf_map &= ~bit;
+        copy->child_map |= bit;
+        copy->children.insert(copy->children.begin() + static_cast<ptrdiff_t>(index_of(copy->child_map, bit)),
+                              std::move(child));
+        added = true;
+        return copy;
+    }
+    auto copy = std::make_shared<Node>(*this);
+    if (child_map & bit)
+    {
+        const size_t index = index_of(child_map, bit);
+        copy->children[index] = children[index]->assoc(std::move(leaf), shift + BITS, added);
+        return copy;
+    }
+    copy->leaf_map |= bit;
+    copy->leaves.insert(copy->leaves.begin() + static_cast<ptrdiff_t>(index_of(copy->leaf_map, bit)),
+                        std::move(leaf));
+    added = true;
+    return copy;
+}
+
+Hamt::NodePtr Hamt::Node::dissoc(const size_t hash, const std::shared_ptr<Expr>& key, const unsigned shift,
+                                 bool& removed) const
+{
+    if (collision)
+    {
+        for (size_t i = 0; i < leaves.size(); ++i)
+        {
+            if (matches(leaves[i], hash, key))
+            {
+                removed = true;
+                if (leaves.size() == 1)
+                {
+                    return nullptr;
+                }
+                auto copy = std::make_shared<Node>(*this);
+                copy->leaves.erase(copy->leaves.begin() + static_cast<ptrdiff_t>(i));
+                return copy;
+            }
+        }
+        return nullptr;
+    }
+    const uint32_t bit = 1u << fragment(hash, shift);
+    if (leaf_map & bit)
+    {
+        const size_t index = index_of(leaf_map, bit);
+        if (!matches(leaves[index], hash, key))
+        {
+            return nullptr;
+        }
+        removed = true;
+        if (leaves.size() == 1 && children.empty())
+        {
+            return nullptr;
+        }
+        auto copy = std::make_shared<Node>(*this);
+        copy->leaves.erase(copy->leaves.begin() + static_cast<ptrdiff_t>(index));
+        copy->leaf_map &= ~bit;
+        return copy;
+    }
+    if (!(child_map & bit))
+    {
+        return nullptr;
+    }
+    const size_t index = index_of(child_map, bit);
+    auto child = children[index]->dissoc(hash, key, shift + BITS, removed);
+    if (!removed)
+    {
+        return nullptr;
+    }
+    auto copy = std::make_shared<Node>(*this);
+    if (child && !(child->children.empty() && child->leaves.size() == 1))
+    {
+        copy->children[index] = std::move(child);
+        return copy;
+    }
+    // The subtree is gone or down to one entry: drop it, pulling a lone entry up into this node
+    copy->children.erase(copy->children.begin() + static_cast<ptrdiff_t>(index));
+    copy->child_map &= ~bit;
+    if (child)
+    {
+        copy->leaf_map |= bit;
+        copy->leaves.insert(copy->leaves.begin() + static_cast<ptrdiff_t>(index_of(copy->leaf_map, bit)),
+                            child->leaves.front());
+    }
+    else if (copy->leaves.empty() && copy->children.empty())
+    {
+        return nullptr;
+    }
+    return copy;
+}
+
+void Hamt::Node::collect(std::vector<Entry>& out) const
+{
+    for (const auto& leaf : leaves)
+    {
+        out.push_back(leaf.entry);
+    }
+    for (const auto& child : children)
+    {
+        child->collect(out);
+    }
+}
+
+size_t Hamt::Node::hash_sum() const
+{
+    size_t sum = 0;
+    for (const auto& leaf : leaves)
+    {
+        sum += leaf.hash;
+    }
+    for (const auto& child : children)
+    {
+        sum += child->hash_sum();
+    }
+    return sum;
+}
+
+Hamt::Hamt(NodePtr root, const size_t count) : root(std::move(root)), count(count) {}
+
+size_t Hamt::size() const
+{
+    return count;
+}
+
+bool Hamt::empty() const
+{
+    return count == 0;
+}
+
+const Hamt::Entry* Hamt::find(const std::shared_ptr<Expr>& key) const
+{
+    if (!root)
+    {
+        return nullptr;
+    }
+    const auto* leaf = root->find(hash_key(*key), key, 0);
+    return leaf ? &leaf->entry : nullptr;
+}
+
+Hamt Hamt::assoc(const std::shared_ptr<Expr>& key, std::shared_ptr<Expr> value) const
+{
+    const size_t hash = hash_key(*key);
+    if (const auto* existing = root ? root->find(hash, key, 0) : nullptr; existing && existing->entry.second == value)
+    {
+        return *this;
+    }
+    Node::Leaf leaf{hash, {key, std::move(value)}};
+    if (!root)
+    {
+        auto node = std::make_shared<Node>();
+        node->leaf_map = 1u << fragment(hash, 0);
+        node->leaves.push_back(std::move(leaf));
+        return {std::move(node), 1};
+    }
+    bool added = false;
+    auto new_root = root->assoc(std::move(leaf), 0, added);
+    return {std::move(new_root), count + (added ? 1 : 0)};
+}
+
+Hamt Hamt::dissoc(const std::shared_ptr<Expr>& key) const
+{
+    if (!root)
+    {
+        return *this;
+    }
+    bool removed = false;
+    auto new_root = root->dissoc(hash_key(*key), key, 0, removed);
+    if (!removed)
+    {
+        return *this;
+    }
+    return {std::move(new_root), count - 1};
+}
+
+std::vector<Hamt::Entry> Hamt::entries() const
+{
+    std::vector<Entry> result;
+    result.reserve(count);
+    if (root)
+    {
+        root->collect(result);
+    }
+    return result;
+}
+
+size_t Hamt::hash() const
+{
+    return root ? root->hash_sum() : 0;
+}
@@ -0,0 +1,344 @@
+//
+// Created by glom on 11/7/25.
+//
+#include "hash_table.h"
+
+#include <bit>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <string>
+
+#include "expr.h"
+#include "primitive.h"
+
+namespace
+{
+    constexpr size_t MIN_CAPACITY = 8;
+    // Nodes of a pair or vector key that feed its equal? hash; the rest only affect equality
+    constexpr size_t EQUAL_HASH_BUDGET = 64;
+
+    // The splitmix64 finalizer, spreading every input bit over the probe index
+    size_t mix(uint64_t x)
+    {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+        return x;
+    }
+
+    size_t combine(const size_t seed, const size_t value)
+    {
+        return mix(seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2)));
+    }
+
+    size_t hash_pointer(const void* pointer)
+    {
+        return mix(reinterpret_cast<uintptr_t>(pointer));
+    }
+
+    // Numbers that compare equal have the same inexact value, so that value is what gets
+    // hashed. Integral values go through int64 so that 2 and 2.0 agree exactly.
+    size_t hash_real(const real value)
+    {
+        constexpr auto limit = static_cast<real>(std::numeric_limits<int64_t>::max());
+        if (std::trunc(value) == value && value > -limit && value < limit)
+        {
+            return mix(static_cast<uint64_t>(static_cast<int64_t>(value)));
+        }
+        return mix(std::hash<real>{}(value));
+    }
+
+    size_t hash_eqv(const Expr& expr)
+    {
+        if (expr.is_number())
+        {
+            return hash_real(expr.to_number_real());
+        }
+        switch (expr.get_type())
+        {
+        case BOOLEAN:
+            return mix(expr.as_boolean());
+        case STRING:
+            return mix(std::hash<std::string>{}(expr.as_string()));
+        case SYMBOL:
+            return hash_pointer(expr.as_symbol().data());
+        default:
+            return hash_pointer(&expr);
+        }
+    }
+
+    size_t hash_numvector(const NumVector& vector, size_t budget)
+    {
+        size_t hash = combine(static_cast<size_t>(vector.kind()), vector.size());
+        for (size_t i = 0; i < vector.size() && budget > 0; ++i, --budget)
+        {
+            uint64_t bits = 0;
+            switch (vector.kind())
+            {
+            case NumVector::Kind::F64:
+            {
+                // 0.0 and -0.0 compare equal
+                const double value = vector.f64()[i] == 0.0 ? 0.0 : vector.f64()[i];
+                bits = std::bit_cast<uint64_t>(value);
+                break;
+            }
+            case NumVector::Kind::S64:
+                bits = static_cast<uint64_t>(vector.s64()[i]);
+                break;
+            case NumVector::Kind::U8:
+                bits = vector.u8()[i];
+                break;
+            }
+            hash = combine(hash, bits);
+        }
+        return hash;
+    }
+
+    // Walks the same nodes in the same order for any two equal? structures, so the shared
+    // budget runs out at the same place in both
+    size_t hash_equal(const Expr& expr, size_t& budget)
+    {
+        if (budget == 0)
+        {
+            return 0;
+        }
+        --budget;
+        switch (expr.get_type())
+        {
+        case PAIR:
+        {
+            size_t hash = mix(PAIR);
+            const Expr* current = &expr;
+            while (current->is_pair() && !current->is_nil() && budget > 0)
+            {
+                --budget;
+                const auto pair = current->as_pair();
+                hash = combine(hash, hash_equal(*pair->car(), budget));
+                current = pair->cdr().get();
+            }
+            return combine(hash, current->is_pair() ? 0 : hash_equal(*current, budget));
+        }
+        case VECTOR:
+        {
+            const auto& elements = *expr.as_vector();
+            size_t hash = combine(mix(VECTOR), elements.size());
+            for (size_t i = 0; i < elements.size() && budget > 0; ++i)
+            {
+                hash = combine(hash, hash_equal(*elements[i], budget));
+            }
+            return hash;
+        }
+        case PVECTOR:
+        {
+            const auto& elements = expr.as_pvector();
+            size_t hash = combine(mix(PVECTOR), elements.size());
+            for (size_t i = 0; i < elements.size() && budget > 0; ++i)
+            {
+                hash = combine(hash, hash_equal(*elements.get(i), budget));
+            }
+            return hash;
+        }
+        case NUMVECTOR:
+            return hash_numvector(*expr.as_numvector(), budget);
+        // Equal maps and sets hold the same keys, whatever order they were added in
+        case PERSISTENT_MAP:
+            return combine(mix(PERSISTENT_MAP), expr.as_persistent_map().hash());
+        case PERSISTENT_SET:
+            return combine(mix(PERSISTENT_SET), expr.as_persistent_set().hash());
+        default:
+            return hash_eqv(expr);
+        }
+    }
+}
+
+HashTable::HashTable(const Equivalence equivalence) : equivalence(equivalence) {}
+
+HashTable::Equivalence HashTable::get_equivalence() const
+{
+    return equivalence;
+}
+
+size_t HashTable::size() const
+{
+    return count;
+}
+
+size_t HashTable::hash(const Equivalence equivalence, const Expr& expr)
+{
+    switch (equivalence)
+    {
+    case Equivalence::EQ:
+        if (expr.is_number_int())
+        {
+            return hash_real(expr.to_number_real());
+        }
+        if (expr.is_symbol())
+        {
+            return hash_pointer(expr.as_symbol().data());
+        }
+        return hash_pointer(&expr);
+    case Equivalence::EQV:
+        return hash_eqv(expr);
+    default:
+    {
+        size_t budget = EQUAL_HASH_BUDGET;
+        return hash_equal(expr, budget);
+    }
+    }
+}
+
+bool HashTable::matches(const Slot& slot, const std::shared_ptr<Expr>& key, const size_t hash) const
+{
+    if (slot.hash != hash)
+    {
+        return false;
+    }
+    switch (equivalence)
+    {
+    case Equivalence::EQ:
+        return primitives_utils::is_eq(slot.key, key);
+    case Equivalence::EQV:
+        return primitives_utils::is_eqv(slot.key, key);
+    default:
+        return primitives_utils::is_equal(slot.key, key);
+    }
+}
+
+size_t HashTable::find(const std::shared_ptr<Expr>& key, const size_t hash) const
+{
+    if (slots.empty())
+    {
+        return 0;
+    }
+    const size_t mask = slots.size() - 1;
+    for (size_t index = hash & mask;; index = (index + 1) & mask)
+    {
+        const auto& slot = slots[index];
+        if (slot.state == SlotState::EMPTY)
+        {
+            return slots.size();
+        }
+        if (slot.state == SlotState::FULL && matches(slot, key, hash))
+        {
+            return index;
+        }
+    }
+}
+
+void HashTable::rehash(const size_t capacity)
+{
+    auto old_slots = std::exchange(slots, std::vector<Slot>(capacity));
+    tombstones = 0;
+    const size_t mask = capacity - 1;
+    for (auto& slot : old_slots)
+    {
+        if (slot.state != SlotState::FULL)
+        {
+            continue;
+        }
+        size_t index = slot.hash & mask;
+        while (slots[index].state != SlotState::EMPTY)
+        {
+            index = (index + 1) & mask;
+        }
+        slots[index] = std::move(slot);
+    }
+}
+
+std::shared_ptr<Expr> HashTable::get(const std::shared_ptr<Expr>& key) const
+{
+    const size_t index = find(key, hash(equivalence, *key));
+    return index < slots.size() ? slots[index].value : nullptr;
+}
+
+void HashTable::set(const std::shared_ptr<Expr>& key, std::shared_ptr<Expr> value)
+{
+    const size_t key_hash = hash(equivalence, *key);
+    if ((count + tombstones + 1) * 4 > slots.size() * 3)
+    {
+        // Grow once live keys fill half the slots, otherwise just sweep out the tombstones
+        rehash(slots.empty() ? MIN_CAPACITY : (count + 1) * 2 > slots.size() ? slots.size() * 2 : slots.size());
+    }
+    const size_t mask = slots.size() - 1;
+    size_t target = slots.size();
+    for (size_t index = key_hash & mask;; index = (index + 1) & mask)
+    {
+        auto& slot = slots[index];
+        if (slot.state == SlotState::EMPTY)
+        {
+            if (target == slots.size())
+            {
+                target = index;
+            }
+            break;
+        }
+        if (slot.state == SlotState::DELETED)
+        {
+            if (target == slots.size())
+            {
+                target = index;
+            }
+            continue;
+        }
+        if (matches(slot, key, key_hash))
+        {
+            slot.value = std::move(value);
+            return;
+        }
+    }
+    auto& slot = slots[target];
+    if (slot.state == SlotState::DELETED)
+    {
+        --tombstones;
+    }
+    slot = Slot{key, std::move(value), key_hash, SlotState::FULL};
+    ++count;
+}
+
+bool HashTable::remove(const std::shared_ptr<Expr>& key)
+{
+    const size_t index = find(key, hash(equivalence, *key));
+    if (index >= slots.size())
+    {
+        return false;
+    }
+    auto& slot = slots[index];
+    slot.key.reset();
+    slot.value.reset();
+    // A slot followed by an empty one ends no probe chain and can be emptied outright
+    if (slots[(index + 1) & (slots.size() - 1)].state == SlotState::EMPTY)
+    {
+        slot.state = SlotState::EMPTY;
+    }
+    else
+    {
+        slot.state = SlotState::DELETED;
+        ++tombstones;
+    }
+    --count;
+    return true;
+}
+
+void HashTable::clear()
+{
+    slots.clear();
+    count = 0;
+    tombstones = 0;
+}
+
+std::vector<HashTable::Entry> HashTable::entries() const
+{
+    std::vector<Entry> result;
+    result.reserve(count);
+    for (const auto& slot : slots)
+    {
+        if (slot.state == SlotState::FULL)
+        {
+            result.emplace_back(slot.key, slot.value);
+        }
+    }
+    return result;
+}
@@ -0,0 +1,211 @@
+//
+// Created by glom on 11/4/25.
+//
+#include "limb_kernels.h"
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define GLOM_X86_64_KERNELS
+#include <immintrin.h>
+#endif
+
+typedef unsigned __int128 uint128_t;
+
+uint64_t limb_kernels::portable::add_n(uint64_t* r, const uint64_t* a, const uint64_t* b, const size_t n)
+{
+    uint64_t carry = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        const uint128_t sum = static_cast<uint128_t>(a[i]) + b[i] + carry;
+        r[i] = static_cast<uint64_t>(sum);
+        carry = static_cast<uint64_t>(sum >> 64);
+    }
+    return carry;
+}
+
+uint64_t limb_kernels::portable::sub_n(uint64_t* r, const uint64_t* a, const uint64_t* b, const size_t n)
+{
+    uint64_t borrow = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        const uint128_t diff = static_cast<uint128_t>(a[i]) - b[i] - borrow;
+        r[i] = static_cast<uint64_t>(diff);
+        borrow = static_cast<uint64_t>(diff >> 64) & 1;
+    }
+    return borrow;
+}
+
+uint64_t limb_kernels::portable::addmul_1(uint64_t* r, const uint64_t* a, const size_t n, const uint64_t b)
+{
+    uint64_t carry = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        const uint128_t t = static_cast<uint128_t>(a[i]) * b + r[i] + carry;
+        r[i] = static_cast<uint64_t>(t);
+        carry = static_cast<uint64_t>(t >> 64);
+    }
+    return carry;
+}
+
+uint64_t limb_kernels::portable::submul_1(uint64_t* r, const uint64_t* a, const size_t n, const uint64_t b)
+{
+    uint64_t carry = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        const uint128_t product = static_cast<uint128_t>(a[i]) * b + carry;
+        const auto low = static_cast<uint64_t>(product);
+        carry = static_cast<uint64_t>(product >> 64);
+        const uint64_t limb = r[i];
+        r[i] = limb - low;
+        carry += limb < low;
+    }
+    return carry;
+}
+
+#ifdef GLOM_X86_64_KERNELS
+namespace
+{
+    // mulx leaves the flags alone, so the low halves and the high halves of consecutive
+    // products are summed in two independent carry chains: adcx on CF and adox on OF. The
+    // loop counter runs from -n up to zero and is stepped with lea and tested with jrcxz,
+    // neither of which touches the flags.
+    uint64_t adx_addmul_1(uint64_t* r, const uint64_t* a, const size_t n, const uint64_t b)
+    {
+        auto index = -static_cast<int64_t>(n);
+        uint64_t high;
+        __asm__(
+            "xorl %k[high], %k[high]\n\t"
+            "1:\n\t"
+            "jrcxz 2f\n\t"
+            "mulx (%[a],%[index],8), %%r8, %%r9\n\t"
+            "adcx (%[r],%[index],8), %%r8\n\t"
+            "adox %[high], %%r8\n\t"
+            "movq %%r8, (%[r],%[index],8)\n\t"
+            "movq %%r9, %[high]\n\t"
+            "leaq 1(%[index]), %[index]\n\t"
+            "jmp 1b\n\t"
+            "2:\n\t"
+            "movl $0, %%r8d\n\t"
+            "adcx %%r8, %[high]\n\t"
+            "adox %%r8, %[high]"
+            : [index] "+c"(index), [high] "=&a"(high)
+            : [r] "r"(r + n), [a] "r"(a + n), "d"(b)
+            : "r8", "r9", "cc", "memory");
+        // The full result fits n + 1 limbs, so the final carries cannot wrap
+        return high;
+    }
+
+    // There is no flag-preserving subtract, so r - t is computed as ~(~r + t): the carry out
+    // of ~r + t is exactly the borrow out of r - t, which keeps both chains on adcx/adox.
+    uint64_t adx_submul_1(uint64_t* r, const uint64_t* a, const size_t n, const uint64_t b)
+    {
+        auto index = -static_cast<int64_t>(n);
+        uint64_t high;
+        __asm__(
+            "xorl %k[high], %k[high]\n\t"
+            "1:\n\t"
+            "jrcxz 2f\n\t"
+            "mulx (%[a],%[index],8), %%r8, %%r9\n\t"
+            "adox %[high], %%r8\n\t"
+            "movq (%[r],%[index],8), %%r10\n\t"
+            "notq %%r10\n\t"
+            "adcx %%r8, %%r10\n\t"
+            "notq %%r10\n\t"
+            "movq %%r10, (%[r],%[index],8)\n\t"
+            "movq %%r9, %[high]\n\t"
+            "leaq 1(%[index]), %[index]\n\t"
+            "jmp 1b\n\t"
+            "2:\n\t"
+            "movl $0, %%r8d\n\t"
+            "adcx %%r8, %[high]\n\t"
+            "adox %%r8, %[high]"
+            : [index] "+c"(index), [high] "=&a"(high)
+            : [r] "r"(r + n), [a] "r"(a + n), "d"(b)
+            : "r8", "r9", "r10", "cc", "memory");
+        return high;
+    }
+}
+#endif
+
+bool limb_kernels::has_adx()
+{
+#ifdef GLOM_X86_64_KERNELS
+    static const bool supported = __builtin_cpu_supports("bmi2") && __builtin_cpu_supports("adx");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+uint64_t limb_kernels::add_n(uint64_t* r, const uint64_t* a, const uint64_t* b, const size_t n)
+{
+#ifdef GLOM_X86_64_KERNELS
+    unsigned char carry = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        unsigned long long sum;
+        carry = _addcarry_u64(carry, a[i], b[i], &sum);
+        r[i] = sum;
+    }
+    return carry;
+#else
+    return portable::add_n(r, a, b, n);
+#endif
+}
+
+uint64_t limb_kernels::sub_n(uint64_t* r, const uint64_t* a, const uint64_t* b, const size_t n)
+{
+#ifdef GLOM_X86_64_KERNELS
+    unsigned char borrow = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        unsigned long long diff;
+        borrow = _subborrow_u64(borrow, a[i], b[i], &diff);
+        r[i] = diff;
+    }
+    return borrow;
+#else
+    return portable::sub_n(r, a, b, n);
+#endif
+}
+
+uint64_t limb_kernels::add_1(uint64_t* r, const uint64_t* a, const size_t n, uint64_t carry)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        const uint64_t limb = a[i];
+        r[i] = limb + carry;
+        carry = r[i] < limb;
+    }
+    return carry;
+}
+
+uint64_t limb_kernels::sub_1(uint64_t* r, const uint64_t* a, const size_t n, uint64_t borrow)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        const uint64_t limb = a[i];
+        r[i] = limb - borrow;
+        borrow = limb < borrow;
+    }
+    return borrow;
+}
+
+uint64_t limb_kernels::addmul_1(uint64_t* r, const uint64_t* a, const size_t n, const uint64_t b)
+{
+#ifdef GLOM_X86_64_KERNELS
+    static const auto kernel = has_adx() ? &adx_addmul_1 : &portable::addmul_1;
+    return kernel(r, a, n, b);
+#else
+    return portable::addmul_1(r, a, n, b);
+#endif
+}
+
+uint64_t limb_kernels::submul_1(uint64_t* r, const uint64_t* a, const size_t n, const uint64_t b)
+{
+#ifdef GLOM_X86_64_KERNELS
+    static const auto kernel = has_adx() ? &adx_submul_1 : &portable::submul_1;
+    return kernel(r, a, n, b);
+#else
+    return portable::submul_1(r, a, n, b);
+#endif
+}
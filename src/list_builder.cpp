@@ -0,0 +1,150 @@
+//
+// Created by glom on 11/10/25.
+//
+#include "list_builder.h"
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+
+#include "expr.h"
+
+namespace
+{
+    constexpr size_t CHUNK_BYTES = 4096;
+
+    // A block of cells, freed once every allocation in it and the arena itself let go
+    struct Chunk
+    {
+        std::atomic<size_t> references{1};
+        size_t used = 0;
+
+        [[nodiscard]] std::byte* storage()
+        {
+            return reinterpret_cast<std::byte*>(this) + sizeof(Chunk);
+        }
+
+        void release()
+        {
+            if (references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                this->~Chunk();
+                ::operator delete(this);
+            }
+        }
+    };
+
+    constexpr size_t CHUNK_CAPACITY = CHUNK_BYTES - sizeof(Chunk);
+
+    // Each allocation is prefixed with its chunk so that any thread can release it
+    class Arena
+    {
+        Chunk* current = nullptr;
+
+        static Chunk* new_chunk()
+        {
+            return new (::operator new(CHUNK_BYTES)) Chunk();
+        }
+
+    public:
+        ~Arena()
+        {
+            if (current)
+            {
+                current->release();
+            }
+        }
+
+        void* allocate(const size_t bytes, const size_t align)
+        {
+            for (int attempt = 0; attempt < 2; ++attempt)
+            {
+                if (!current)
+                {
+                    current = new_chunk();
+                }
+                const size_t start = (current->used + sizeof(Chunk*) + align - 1) / align * align;
+                if (start + bytes <= CHUNK_CAPACITY)
+                {
+                    std::byte* object = current->storage() + start;
+                    *reinterpret_cast<Chunk**>(object - sizeof(Chunk*)) = current;
+                    current->used = start + bytes;
+                    current->references.fetch_add(1, std::memory_order_relaxed);
+                    return object;
+                }
+                current->release();
+                current = nullptr;
+            }
+            throw std::bad_alloc();
+        }
+
+        static void deallocate(void* object)
+        {
+            (*reinterpret_cast<Chunk**>(static_cast<std::byte*>(object) - sizeof(Chunk*)))->release();
+        }
+    };
+
+    thread_local Arena arena;
+
+    template <typename T>
+    struct CellAllocator
+    {
+        using value_type = T;
+
+        CellAllocator() = default;
+
+        template <typename U>
+        explicit CellAllocator(const CellAllocator<U>&) {}
+
+        T* allocate(const size_t n)
+        {
+            return static_cast<T*>(arena.allocate(sizeof(T) * n, alignof(T)));
+        }
+
+        void deallocate(T* object, size_t)
+        {
+            Arena::deallocate(object);
+        }
+
+        template <typename U>
+        bool operator==(const CellAllocator<U>&) const
+        {
+            return true;
+        }
+    };
+}
+
+void ListBuilder::push_back(std::shared_ptr<Expr> value)
+{
+    auto pair = std::allocate_shared<Pair>(CellAllocator<Pair>(), Pair(std::move(value), Expr::NIL));
+    auto cell = std::allocate_shared<Expr>(CellAllocator<Expr>(), Expr(std::shared_ptr(pair)));
+    if (!head)
+    {
+        head = std::move(cell);
+    }
+    else
+    {
+        tail->set_cdr(std::move(cell));
+    }
+    tail = std::move(pair);
+}
+
+void ListBuilder::set_tail(std::shared_ptr<Expr> rest)
+{
+    tail->set_cdr(std::move(rest));
+}
+
+bool ListBuilder::empty() const
+{
+    return !head;
+}
+
+std::shared_ptr<Expr> ListBuilder::build() const
+{
+    return head ? head : Expr::NIL;
+}
+
+std::shared_ptr<Pair> ListBuilder::build_pair() const
+{
+    return head ? head->as_pair() : Pair::EMPTY;
+}
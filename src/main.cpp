@@ -2,10 +2,12 @@
 #include <string>
 #include <memory>
 #include <sstream>
+#include <vector>
 
 #include "parser.h"
 #include "context.h"
 #include "expr.h"
+#include "thread_pool.h"
 
 using namespace std::string_literals;
 
@@ -269,12 +271,12 @@ void run_file(const shared_ptr<Context>& context, const char* filename) {
 
 }
 
-void run_files(const int argc, char *argv[]) {
+void run_files(const std::vector<const char*>& files) {
     const auto context = make_root_context();
     // Process each file argument
     try {
-        for (int i = 1; i < argc; i++) {
-            run_file(context, argv[i]);
+        for (const auto file : files) {
+            run_file(context, file);
         }
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << '\n';
@@ -285,10 +287,19 @@ void run_files(const int argc, char *argv[]) {
 
 int main(const int argc, char *argv[])
 {
-    if (argc == 1) {
+    std::vector<const char*> files;
+    for (int i = 1; i < argc; i++) {
+        // --threads N sizes the pool used for huge bignum multiplications
+        if (std::string(argv[i]) == "--threads" && i + 1 < argc) {
+            ThreadPool::instance().resize(std::max(1, std::atoi(argv[++i])));
+            continue;
+        }
+        files.push_back(argv[i]);
+    }
+    if (files.empty()) {
         return start_repl();
     }
-    run_files(argc, argv);
+    run_files(files);
 
     return 0;
 }
\ No newline at end of file
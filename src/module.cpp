@@ -63,7 +63,7 @@ shared_ptr<const Context> Context::get_module_exports() const
         return nullptr;
     }
     const shared_ptr<Context> exports = new_context();
-    for (const auto export_keys = export_keys_expr->as_pair(); const auto key : *export_keys)
+    for (const auto export_keys = export_keys_expr->as_pair(); const auto& key : *export_keys)
     {
         if (!key) break;
         if (!key->is_symbol())
@@ -3,8 +3,10 @@
 //
 
 #include <algorithm>
+#include <bit>
 #include <charconv>
 #include <cmath>
+#include <cstdlib>
 #include <iomanip>
 
 #include "type.h"
@@ -14,7 +16,21 @@ integer::integer() : value(static_cast<int64_t>(0)) {}
 
 integer::integer(int64_t val) : value(val) {}
 
-integer::integer(BigInt val) : value(std::make_unique<BigInt>(std::move(val))) {}
+integer::integer(BigInt val) {
+    // Keep the representation canonical: results that fit in a machine word go back to int64_t
+    if (const auto& limbs = val.get_data(); limbs.size() == 1) {
+        const uint64_t magnitude = limbs[0];
+        if (!val.is_negative_sign() && magnitude <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+            value = static_cast<int64_t>(magnitude);
+            return;
+        }
+        if (val.is_negative_sign() && magnitude <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) + 1) {
+            value = static_cast<int64_t>(~magnitude + 1);
+            return;
+        }
+    }
+    value = std::make_unique<BigInt>(std::move(val));
+}
 
 
 integer::integer(const std::string& str) {
@@ -92,13 +108,12 @@ integer integer::operator+(const integer& other) const {
     if (is_int64() && other.is_int64()) {
         const int64_t a = as_int64();
         const int64_t b = other.as_int64();
-        // Check for overflow
-        if ((b > 0 && a > std::numeric_limits<int64_t>::max() - b) ||
-            (b < 0 && a < std::numeric_limits<int64_t>::min() - b)) {
+        int64_t result;
+        if (__builtin_add_overflow(a, b, &result)) [[unlikely]] {
             // Convert to BigInt
             return integer(BigInt(a) + BigInt(b));
         }
-        return integer(a + b);
+        return integer(result);
     }
     return integer(to_bigint() + other.to_bigint());
 }
@@ -107,13 +122,12 @@ integer integer::operator-(const integer& other) const {
     if (is_int64() && other.is_int64()) {
         const int64_t a = as_int64();
         const int64_t b = other.as_int64();
-        // Check for overflow
-        if ((b > 0 && a < std::numeric_limits<int64_t>::min() + b) ||
-            (b < 0 && a > std::numeric_limits<int64_t>::max() + b)) {
+        int64_t result;
+        if (__builtin_sub_overflow(a, b, &result)) [[unlikely]] {
             // Convert to BigInt
             return integer(BigInt(a) - BigInt(b));
         }
-        return integer(a - b);
+        return integer(result);
     }
     return integer(to_bigint() - other.to_bigint());
 }
@@ -122,30 +136,11 @@ integer integer::operator*(const integer& other) const {
     if (is_int64() && other.is_int64()) {
         const int64_t a = as_int64();
         const int64_t b = other.as_int64();
-
-        // Check for overflow
-        if (a > 0) {
-            if (b > 0) {
-                if (a > std::numeric_limits<int64_t>::max() / b) {
-                    return integer(BigInt(a) * BigInt(b));
-                }
-            } else {
-                if (b < std::numeric_limits<int64_t>::min() / a) {
-                    return integer(BigInt(a) * BigInt(b));
-                }
-            }
-        } else {
-            if (b > 0) {
-                if (a < std::numeric_limits<int64_t>::min() / b) {
-                    return integer(BigInt(a) * BigInt(b));
-                }
-            } else {
-                if (a != 0 && b < std::numeric_limits<int64_t>::max() / a) {
-                    return integer(BigInt(a) * BigInt(b));
-                }
-            }
+        int64_t result;
+        if (__builtin_mul_overflow(a, b, &result)) [[unlikely]] {
+            return integer(BigInt(a) * BigInt(b));
         }
-        return integer(a * b);
+        return integer(result);
     }
     return integer(to_bigint() * other.to_bigint());
 }
@@ -205,6 +200,124 @@ integer integer::modulo(const integer& mod) const {
     return rem;
 }
 
+integer integer::expt_mod(const integer& exponent, const integer& modulus) const {
+    if (exponent.is_negative()) {
+        throw std::domain_error("Exponent must be non-negative");
+    }
+    if (!modulus.is_positive()) {
+        throw std::domain_error("Modulus must be positive");
+    }
+    // Reduce into [0, modulus) by hand: modulo gets the sign wrong for negative dividends
+    integer base = remainder(modulus);
+    if (base.is_negative()) {
+        base = base + modulus;
+    }
+    if (base.is_int64() && exponent.is_int64() && modulus.is_int64()) {
+        // Word-sized operands: square-and-multiply on 128-bit products
+        const auto m = static_cast<uint64_t>(modulus.as_int64());
+        auto b = static_cast<uint64_t>(base.as_int64());
+        auto e = static_cast<uint64_t>(exponent.as_int64());
+        uint64_t result = 1 % m;
+        while (e > 0) {
+            if (e & 1) {
+                result = static_cast<uint64_t>(static_cast<uint128_t>(result) * b % m);
+            }
+            b = static_cast<uint64_t>(static_cast<uint128_t>(b) * b % m);
+            e >>= 1;
+        }
+        return integer(static_cast<int64_t>(result));
+    }
+    return integer(BigInt(UBigInt::expt_mod(base.to_bigint().abs(), exponent.to_bigint().abs(), modulus.to_bigint().abs())));
+}
+
+integer integer::product(std::vector<integer> factors) {
+    if (factors.empty()) {
+        return integer(1);
+    }
+    while (factors.size() > 1) {
+        std::vector<integer> next;
+        next.reserve((factors.size() + 1) / 2);
+        for (size_t i = 0; i + 1 < factors.size(); i += 2) {
+            next.push_back(factors[i] * factors[i + 1]);
+        }
+        if (factors.size() % 2 == 1) {
+            next.push_back(std::move(factors.back()));
+        }
+        factors = std::move(next);
+    }
+    return std::move(factors.front());
+}
+
+integer integer::factorial(const uint64_t n) {
+    return integer(BigInt(UBigInt::factorial(n)));
+}
+
+integer integer::binomial(const uint64_t n, const uint64_t k) {
+    return integer(BigInt(UBigInt::binomial(n, k)));
+}
+
+integer integer::bitwise_and(const integer& other) const {
+    if (is_int64() && other.is_int64()) {
+        return integer(as_int64() & other.as_int64());
+    }
+    return integer(to_bigint().bitwise_and(other.to_bigint()));
+}
+
+integer integer::bitwise_or(const integer& other) const {
+    if (is_int64() && other.is_int64()) {
+        return integer(as_int64() | other.as_int64());
+    }
+    return integer(to_bigint().bitwise_or(other.to_bigint()));
+}
+
+integer integer::bitwise_xor(const integer& other) const {
+    if (is_int64() && other.is_int64()) {
+        return integer(as_int64() ^ other.as_int64());
+    }
+    return integer(to_bigint().bitwise_xor(other.to_bigint()));
+}
+
+integer integer::bitwise_not() const {
+    if (is_int64()) {
+        return integer(~as_int64());
+    }
+    return integer(to_bigint().bitwise_not());
+}
+
+integer integer::arithmetic_shift(const int64_t shift) const {
+    if (is_int64()) {
+        const int64_t value = as_int64();
+        if (shift <= 0) {
+            // >> on a negative int64 is arithmetic (floor) since C++20
+            return integer(shift <= -64 ? (value < 0 ? -1 : 0) : value >> -shift);
+        }
+        // Left shifts stay in a word while the value keeps a sign bit to spare
+        if (shift < 63) {
+            const int64_t limit = std::numeric_limits<int64_t>::max() >> shift;
+            if (value <= limit && value >= -limit - 1) {
+                return integer(static_cast<int64_t>(static_cast<uint64_t>(value) << shift));
+            }
+        }
+    }
+    return integer(to_bigint().arithmetic_shift(shift));
+}
+
+uint64_t integer::bit_count() const {
+    if (is_int64()) {
+        const int64_t value = as_int64();
+        return std::popcount(static_cast<uint64_t>(value < 0 ? ~value : value));
+    }
+    return as_bigint().bit_count();
+}
+
+uint64_t integer::integer_length() const {
+    if (is_int64()) {
+        const int64_t value = as_int64();
+        return std::bit_width(static_cast<uint64_t>(value < 0 ? ~value : value));
+    }
+    return as_bigint().integer_length();
+}
+
 integer integer::pow(const integer& exponent) const {
     if (is_int64() && exponent.is_int64()) {
         const int64_t base_val = as_int64();
@@ -348,6 +461,47 @@ std::string integer::to_decimal_string() const {
     return as_bigint().to_decimal_string();
 }
 
+std::string integer::to_string(const unsigned radix) const {
+    if (is_int64()) {
+        char buffer[72];
+        const auto [ptr, ec] = std::to_chars(buffer, buffer + sizeof(buffer), as_int64(), static_cast<int>(radix));
+        if (ec != std::errc()) {
+            throw std::invalid_argument("Unsupported radix " + std::to_string(radix));
+        }
+        return {buffer, ptr};
+    }
+    const auto& big = as_bigint();
+    const auto digits = big.abs().to_string(radix);
+    return big.is_negative_sign() ? "-" + digits : digits;
+}
+
+std::optional<integer> integer::parse(std::string_view text, const unsigned radix) {
+    bool negative = false;
+    if (!text.empty() && (text.front() == '+' || text.front() == '-')) {
+        negative = text.front() == '-';
+        text.remove_prefix(1);
+    }
+    if (text.empty()) {
+        return std::nullopt;
+    }
+    // Anything that fits a word parses without allocating
+    if (uint64_t magnitude = 0; text.size() <= 64) {
+        const auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), magnitude, static_cast<int>(radix));
+        if (ptr != text.data() + text.size() && ec == std::errc()) {
+            return std::nullopt;
+        }
+        if (ec == std::errc() && magnitude <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+            const auto value = static_cast<int64_t>(magnitude);
+            return integer(negative ? -value : value);
+        }
+    }
+    auto magnitude = UBigInt::parse(text, radix);
+    if (!magnitude) {
+        return std::nullopt;
+    }
+    return integer(BigInt(std::move(*magnitude), negative));
+}
+
 real integer::to_real() const {
     if (is_int64()) {
         return static_cast<real>(as_int64());
@@ -362,14 +516,89 @@ rational integer::to_rational() const {
 
 real from_string(const std::string& str)
 {
+    // from_chars rounds correctly (Eisel-Lemire fast path for double), but rejects a leading '+'
+    const char* first = str.data();
+    const char* last = str.data() + str.size();
+    if (first != last && *first == '+')
+    {
+        ++first;
+    }
     real val = 0;
-    if (auto [_,err] = std::from_chars(str.data(), str.data() + str.size(), val); err != std::errc())
+    const auto [ptr, err] = std::from_chars(first, last, val);
+    if (err == std::errc::result_out_of_range && ptr == last)
+    {
+        // Overflow reads as an infinity and underflow as zero
+        return static_cast<real>(std::strtold(std::string(first, last).c_str(), nullptr));
+    }
+    if (err != std::errc() || ptr != last)
     {
         throw std::runtime_error("BigInt to real conversion failed");
     }
     return val;
 }
 
+namespace
+{
+    // Shortest representation that reads back to the same value of the given width
+    template <typename Flonum>
+    std::string flonum_to_string(const Flonum val)
+    {
+        if (std::isnan(val))
+        {
+            return "+nan.0";
+        }
+        if (std::isinf(val))
+        {
+            return val > 0 ? "+inf.0" : "-inf.0";
+        }
+        char buffer[64];
+        const auto [ptr, err] = std::to_chars(buffer, buffer + sizeof(buffer), val);
+        if (err != std::errc())
+        {
+            throw std::runtime_error("Real to string conversion failed");
+        }
+        std::string result(buffer, ptr);
+        // Keep the printed form inexact: 2.0 rather than 2
+        if (result.find_first_of(".e") == std::string::npos)
+        {
+            result += ".0";
+        }
+        return result;
+    }
+}
+
+std::string to_string(const real val, const size_t base)
+{
+    if (base != 10)
+    {
+        throw std::domain_error("Inexact numbers can only be written in base 10");
+    }
+    return flonum_to_string(val);
+}
+
+std::string f64_to_string(const double val)
+{
+    return flonum_to_string(val);
+}
+
+real f64_to_real(const double val)
+{
+#ifdef GLOM_FLONUM_DOUBLE
+    return val;
+#else
+    if (!std::isfinite(val))
+    {
+        return val;
+    }
+    // Widen through the shortest decimal form, so 0.1 stored as a double reads back as the real 0.1
+    char buffer[32];
+    const auto printed = std::to_chars(buffer, buffer + sizeof(buffer), val);
+    real result = 0;
+    std::from_chars(buffer, printed.ptr, result);
+    return result;
+#endif
+}
+
 void rational::normalize() {
     if (den.is_zero()) {
         throw std::runtime_error("Zero denominator in rational");
@@ -394,10 +623,46 @@ void rational::normalize() {
 }
 
 integer rational::gcd(const integer& a, const integer& b) {
-    if (b.is_zero()) {
-        return a;
+    if (a.is_int64() && b.is_int64()) {
+        const auto magnitude = [](const int64_t v) {
+            return v < 0 ? ~static_cast<uint64_t>(v) + 1 : static_cast<uint64_t>(v);
+        };
+        const uint64_t g = UBigInt::gcd_word(magnitude(a.as_int64()), magnitude(b.as_int64()));
+        return integer(BigInt(g));
     }
-    return gcd(b, a.modulo(b));
+    return integer(BigInt(UBigInt::gcd(a.to_bigint().abs(), b.to_bigint().abs())));
+}
+
+rational rational::unreduced(integer num, integer den) {
+    rational result;
+    result.num = std::move(num);
+    result.den = std::move(den);
+    return result;
+}
+
+rational rational::add_unreduced(const rational& other) const {
+    // Common denominators (prices in cents, ...) only need the numerators added
+    if (den == other.den) {
+        return unreduced(num + other.num, den);
+    }
+    return unreduced(num * other.den + other.num * den, den * other.den);
+}
+
+rational rational::sub_unreduced(const rational& other) const {
+    if (den == other.den) {
+        return unreduced(num - other.num, den);
+    }
+    return unreduced(num * other.den - other.num * den, den * other.den);
+}
+
+rational rational::mul_unreduced(const rational& other) const {
+    return unreduced(num * other.num, den * other.den);
+}
+
+bool rational::should_reduce() const {
+    // Past a few words the quadratic cost of carrying common factors outgrows one gcd
+    constexpr size_t max_unreduced_bits = 512;
+    return den.is_bigint() && den.as_bigint().bit_length() > max_unreduced_bits;
 }
 
 rational::rational() : num(0), den(1) {}
@@ -440,22 +705,21 @@ bool rational::is_integer() const {
 }
 
 rational rational::operator+(const rational& other) const {
-    const integer num1 = num * other.den;
-    const integer num2 = other.num * den;
-    integer new_den = den * other.den;
-    return {num1 + num2, std::move(new_den)};
+    rational result = add_unreduced(other);
+    result.normalize();
+    return result;
 }
 
 rational rational::operator-(const rational& other) const {
-    const integer num1 = num * other.den;
-    const integer num2 = other.num * den;
-    integer new_den = den * other.den;
-    return {num1 - num2, std::move(new_den)};
+    rational result = sub_unreduced(other);
+    result.normalize();
+    return result;
 }
 
 rational rational::operator*(const rational& other) const {
-    return {num * other.num,
-                   den * other.den};
+    rational result = mul_unreduced(other);
+    result.normalize();
+    return result;
 }
 
 rational rational::operator/(const rational& other) const {
@@ -553,55 +817,22 @@ std::variant<integer, real> integer::sqrt() const {
         throw std::domain_error("Cannot compute square root of negative number");
     }
 
-    if (is_zero()) {
-        return integer(0);
-    }
-
-    if (is_one()) {
-        return integer(1);
-    }
-
     if (is_int64()) {
-        if (const int64_t val = as_int64(); val <= 1LL << 53) {
-            real root = std::sqrt(static_cast<real>(val));
-            if (const real nearest_int = std::round(root); std::abs(root - nearest_int) < 1e-10) {
-                return integer(static_cast<int64_t>(nearest_int));
-            }
-            return root;
+        const auto value = static_cast<uint64_t>(as_int64());
+        if (const uint64_t root = UBigInt::isqrt_word(value); root * root == value) {
+            return integer(static_cast<int64_t>(root));
         }
+        return std::sqrt(to_real());
     }
 
-    const BigInt big_val = to_bigint();
-    const UBigInt n = big_val.abs();
-
-    if (n.is_one()) {
-        return integer(1);
-    }
-
-    UBigInt low(1);
-    UBigInt high = n;
-
-    while (low <= high) {
-        UBigInt mid = (low + high) / UBigInt(2);
-
-        if (UBigInt square = mid * mid; square == n) {
-            return integer(BigInt(std::move(mid)));
-        } else if (square < n) {
-            low = mid + UBigInt(1);
-        } else {
-            high = mid - UBigInt(1);
+    // Most non-squares are rejected by their residues before any root is computed
+    const UBigInt& n = as_bigint().abs();
+    if (UBigInt::maybe_square(n)) {
+        if (UBigInt root = UBigInt::isqrt(n); root * root == n) {
+            return integer(BigInt(std::move(root)));
         }
     }
-
-    real real_n = 0.0;
-    real factor = 1.0;
-
-    for (const auto& data = n.get_data(); const unsigned long it : std::ranges::reverse_view(data)) {
-        real_n += static_cast<real>(it) * factor;
-        factor *= static_cast<real>(18446744073709551615.0) + 1.0; // 2^64
-    }
-
-    return std::sqrt(real_n);
+    return std::sqrt(to_real());
 }
 
 integer integer::isqrt() const { // integer square root (floor)
@@ -609,34 +840,23 @@ integer integer::isqrt() const { // integer square root (floor)
         throw std::domain_error("Cannot compute square root of negative number");
     }
 
-    if (is_zero() || is_one()) {
-        return *this;
+    if (is_int64()) {
+        return integer(static_cast<int64_t>(UBigInt::isqrt_word(static_cast<uint64_t>(as_int64()))));
     }
+    return integer(BigInt(UBigInt::isqrt(as_bigint().abs())));
+}
 
-    // 使用二分查找法计算整数平方根（向下取整）
-    const BigInt big_val = to_bigint();
-    const UBigInt n = big_val.abs();
-
-    UBigInt low(1);
-    UBigInt high = n;
-    UBigInt result(0);
-
-    while (low <= high) {
-        UBigInt mid = (low + high) / UBigInt(2);
-        UBigInt square = mid * mid;
-
-        if (square == n) {
-            return integer(BigInt(mid, false));
-        }
-        if (square < n) {
-            result = mid;
-            low = mid + UBigInt(1);
-        } else {
-            high = mid - UBigInt(1);
+integer integer::iroot(const uint64_t k) const {
+    if (k == 0) {
+        throw std::domain_error("Zeroth root is undefined");
+    }
+    if (is_negative()) {
+        if (k % 2 == 0) {
+            throw std::domain_error("Cannot compute even root of negative number");
         }
+        return -(-*this).iroot(k);
     }
-
-    return integer(BigInt(result, false));
+    return integer(BigInt(UBigInt::iroot(to_bigint().abs(), k)));
 }
 
 std::string rational::to_rational_string() const {
@@ -646,10 +866,22 @@ std::string rational::to_rational_string() const {
     return num.to_decimal_string() + "/" + den.to_decimal_string();
 }
 
+std::string rational::to_string(const unsigned radix) const {
+    if (is_integer()) {
+        return num.to_string(radix);
+    }
+    return num.to_string(radix) + "/" + den.to_string(radix);
+}
+
 real rational::to_inexact() const {
-    const real num_real = from_string(num.to_decimal_string());
-    const real den_real = from_string(den.to_decimal_string());
-    return num_real / den_real;
+    constexpr int64_t exact_limit = int64_t{1} << std::min(std::numeric_limits<real>::digits, 62);
+    if (num.is_int64() && den.is_int64() && num.as_int64() >= -exact_limit && num.as_int64() <= exact_limit &&
+        den.as_int64() <= exact_limit) {
+        // Both convert exactly, so the one hardware division rounds correctly
+        return static_cast<real>(num.as_int64()) / static_cast<real>(den.as_int64());
+    }
+    const real value = UBigInt::ratio_to_real(num.to_bigint().abs(), den.to_bigint().abs());
+    return num.is_negative() ? -value : value;
 }
 
 rational rational::exact_rational(const integer& num, const integer& den) {
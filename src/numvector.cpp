@@ -0,0 +1,249 @@
+//
+// Created by glom on 11/6/25.
+//
+#include "numvector.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "type.h"
+
+NumVector::NumVector(const Kind kind, const size_t size)
+{
+    switch (kind)
+    {
+    case Kind::F64:
+        elements = std::vector<double>(size, 0.0);
+        break;
+    case Kind::S64:
+        elements = std::vector<int64_t>(size, 0);
+        break;
+    case Kind::U8:
+        elements = std::vector<uint8_t>(size, 0);
+        break;
+    }
+}
+
+NumVector::NumVector(std::vector<double> values) : elements(std::move(values)) {}
+NumVector::NumVector(std::vector<int64_t> values) : elements(std::move(values)) {}
+NumVector::NumVector(std::vector<uint8_t> values) : elements(std::move(values)) {}
+
+NumVector::Kind NumVector::kind() const
+{
+    return static_cast<Kind>(elements.index());
+}
+
+size_t NumVector::size() const
+{
+    return std::visit([](const auto& values) { return values.size(); }, elements);
+}
+
+std::vector<double>& NumVector::f64() { return std::get<std::vector<double>>(elements); }
+const std::vector<double>& NumVector::f64() const { return std::get<std::vector<double>>(elements); }
+std::vector<int64_t>& NumVector::s64() { return std::get<std::vector<int64_t>>(elements); }
+const std::vector<int64_t>& NumVector::s64() const { return std::get<std::vector<int64_t>>(elements); }
+std::vector<uint8_t>& NumVector::u8() { return std::get<std::vector<uint8_t>>(elements); }
+const std::vector<uint8_t>& NumVector::u8() const { return std::get<std::vector<uint8_t>>(elements); }
+
+std::string NumVector::tag(const Kind kind)
+{
+    switch (kind)
+    {
+    case Kind::F64:
+        return "f64";
+    case Kind::S64:
+        return "s64";
+    default:
+        return "u8";
+    }
+}
+
+std::string NumVector::to_string() const
+{
+    std::string result = "#" + tag(kind()) + "(";
+    for (size_t i = 0; i < size(); ++i)
+    {
+        if (i > 0)
+        {
+            result += " ";
+        }
+        switch (kind())
+        {
+        case Kind::F64:
+            result += f64_to_string(f64()[i]);
+            break;
+        case Kind::S64:
+            result += std::to_string(s64()[i]);
+            break;
+        case Kind::U8:
+            result += std::to_string(u8()[i]);
+            break;
+        }
+    }
+    return result + ")";
+}
+
+bool NumVector::operator==(const NumVector& other) const
+{
+    return elements == other.elements;
+}
+
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(__clang__)
+#define GLOM_TARGET_CLONES __attribute__((target_clones("avx2", "default")))
+#else
+#define GLOM_TARGET_CLONES
+#endif
+
+namespace
+{
+    // Four doubles; aligned(8) and may_alias make dereferencing any double* a valid unaligned load
+    typedef double f64x4 __attribute__((vector_size(32), aligned(8), may_alias));
+    // Lane masks produced by comparing two f64x4
+    typedef int64_t i64x4 __attribute__((vector_size(32)));
+    constexpr size_t LANES = 4;
+}
+
+#define LOAD(p) (*reinterpret_cast<const f64x4*>(p))
+#define STORE(p, v) (*reinterpret_cast<f64x4*>(p) = (v))
+
+GLOM_TARGET_CLONES
+double numvector_kernels::sum(const double* a, const size_t n)
+{
+    // Two accumulators hide the latency of the dependent vector adds
+    f64x4 acc0 = {};
+    f64x4 acc1 = {};
+    size_t i = 0;
+    for (; i + 2 * LANES <= n; i += 2 * LANES)
+    {
+        acc0 += LOAD(a + i);
+        acc1 += LOAD(a + i + LANES);
+    }
+    const f64x4 acc = acc0 + acc1;
+    double total = (acc[0] + acc[1]) + (acc[2] + acc[3]);
+    for (; i < n; ++i)
+    {
+        total += a[i];
+    }
+    return total;
+}
+
+GLOM_TARGET_CLONES
+double numvector_kernels::dot(const double* a, const double* b, const size_t n)
+{
+    f64x4 acc0 = {};
+    f64x4 acc1 = {};
+    size_t i = 0;
+    for (; i + 2 * LANES <= n; i += 2 * LANES)
+    {
+        acc0 += LOAD(a + i) * LOAD(b + i);
+        acc1 += LOAD(a + i + LANES) * LOAD(b + i + LANES);
+    }
+    const f64x4 acc = acc0 + acc1;
+    double total = (acc[0] + acc[1]) + (acc[2] + acc[3]);
+    for (; i < n; ++i)
+    {
+        total += a[i] * b[i];
+    }
+    return total;
+}
+
+GLOM_TARGET_CLONES
+void numvector_kernels::add(double* r, const double* a, const double* b, const size_t n)
+{
+    size_t i = 0;
+    for (; i + LANES <= n; i += LANES)
+    {
+        STORE(r + i, LOAD(a + i) + LOAD(b + i));
+    }
+    for (; i < n; ++i)
+    {
+        r[i] = a[i] + b[i];
+    }
+}
+
+GLOM_TARGET_CLONES
+void numvector_kernels::mul(double* r, const double* a, const double* b, const size_t n)
+{
+    size_t i = 0;
+    for (; i + LANES <= n; i += LANES)
+    {
+        STORE(r + i, LOAD(a + i) * LOAD(b + i));
+    }
+    for (; i < n; ++i)
+    {
+        r[i] = a[i] * b[i];
+    }
+}
+
+GLOM_TARGET_CLONES
+void numvector_kernels::scale(double* r, const double* a, const double s, const size_t n)
+{
+    size_t i = 0;
+    for (; i + LANES <= n; i += LANES)
+    {
+        STORE(r + i, LOAD(a + i) * s);
+    }
+    for (; i < n; ++i)
+    {
+        r[i] = a[i] * s;
+    }
+}
+
+GLOM_TARGET_CLONES
+double numvector_kernels::min(const double* a, const size_t n)
+{
+    // NaN compares false either way, so it is tracked on the side rather than left to the select
+    bool unordered = false;
+    double result = a[0];
+    size_t i = 0;
+    if (n >= LANES)
+    {
+        f64x4 acc = LOAD(a);
+        i64x4 nan = acc != acc;
+        for (i = LANES; i + LANES <= n; i += LANES)
+        {
+            const f64x4 v = LOAD(a + i);
+            nan |= v != v;
+            acc = v < acc ? v : acc;
+        }
+        unordered = (nan[0] | nan[1] | nan[2] | nan[3]) != 0;
+        result = std::min(std::min(acc[0], acc[1]), std::min(acc[2], acc[3]));
+    }
+    for (; i < n; ++i)
+    {
+        unordered |= a[i] != a[i];
+        result = a[i] < result ? a[i] : result;
+    }
+    return unordered ? std::numeric_limits<double>::quiet_NaN() : result;
+}
+
+GLOM_TARGET_CLONES
+double numvector_kernels::max(const double* a, const size_t n)
+{
+    bool unordered = false;
+    double result = a[0];
+    size_t i = 0;
+    if (n >= LANES)
+    {
+        f64x4 acc = LOAD(a);
+        i64x4 nan = acc != acc;
+        for (i = LANES; i + LANES <= n; i += LANES)
+        {
+            const f64x4 v = LOAD(a + i);
+            nan |= v != v;
+            acc = v > acc ? v : acc;
+        }
+        unordered = (nan[0] | nan[1] | nan[2] | nan[3]) != 0;
+        result = std::max(std::max(acc[0], acc[1]), std::max(acc[2], acc[3]));
+    }
+    for (; i < n; ++i)
+    {
+        unordered |= a[i] != a[i];
+        result = a[i] > result ? a[i] : result;
+    }
+    return unordered ? std::numeric_limits<double>::quiet_NaN() : result;
+}
+
+#undef LOAD
+#undef STORE
@@ -5,6 +5,7 @@
 #include "parser.h"
 #include "tokenizer.h"
 #include "expr.h"
+#include "list_builder.h"
 
 class Parser
 {
@@ -41,8 +42,7 @@ public:
             return Expr::make_symbol(std::move(token.as_string()));
         case TOKEN_LPAREN:
             {
-                shared_ptr<Pair> pair = nullptr;
-                shared_ptr<Pair> current = nullptr;
+                ListBuilder list;
 
                 while (true)
                 {
@@ -54,7 +54,7 @@ public:
 
                     if (nextToken.get_type() == TOKEN_SYMBOL && nextToken.as_string() == "." && quoted)
                     {
-                        if (!current)
+                        if (list.empty())
                             throw std::runtime_error("Unexpected '.' without preceding element");
 
                         // Parse the cdr expression after the dot
@@ -64,30 +64,30 @@ public:
                         if (Token endToken = tokenizer.next(); endToken.get_type() != TOKEN_RPAREN)
                             throw std::runtime_error("Expected ')' after dotted pair");
 
-                        current->set_cdr(std::move(cdrExpr));
+                        list.set_tail(std::move(cdrExpr));
                         break;
                     }
 
                     // Regular element
-                    auto next_expr = parse_with(std::move(nextToken));
-                    auto next_pair = Pair::single(std::move(next_expr));
+                    list.push_back(parse_with(std::move(nextToken)));
+                }
 
-                    if (!pair)
-                    {
-                        pair = next_pair;
-                        current = pair;
-                    }
-                    else
+                return list.build();
+            }
+        case TOKEN_VECTOR_LPAREN:
+            {
+                // Vector literals are self-evaluating, their elements are read as data
+                auto elements = std::make_shared<Vector>();
+                while (true)
+                {
+                    Token nextToken = tokenizer.next();
+                    if (nextToken.get_type() == TOKEN_RPAREN)
                     {
-                        current->set_cdr(Expr::make_pair(next_pair));
-                        current = next_pair;
+                        break;
                     }
+                    elements->push_back(parse_with(std::move(nextToken)));
                 }
-
-                if (!pair)
-                    return Expr::NIL;
-
-                return Expr::make_pair(pair);
+                return Expr::make_vector(std::move(elements));
             }
         case TOKEN_QUOTE:
             {
@@ -111,28 +111,17 @@ public:
 
     shared_ptr<Pair> parse()
     {
-        shared_ptr<Pair> result = nullptr;
-        shared_ptr<Pair> current = nullptr;
+        ListBuilder result;
         Token token = tokenizer.next();
         while (token.get_type() != TOKEN_EOI)
         {
             auto next = parse_with(std::move(token));
-            if (!result && next == Expr::NIL)
+            if (result.empty() && next == Expr::NIL)
                 throw std::runtime_error("invalid syntax ()");
-            if (!result)
-            {
-                result = Pair::single(std::move(next));
-                current = result;
-            }
-            else
-            {
-                const auto next_pair = Pair::single(std::move(next));
-                current->set_cdr(Expr::make_pair(next_pair));
-                current = next_pair;
-            }
+            result.push_back(std::move(next));
             token = tokenizer.next();
         }
-        return result;
+        return result.empty() ? nullptr : result.build_pair();
     }
 };
 
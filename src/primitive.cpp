@@ -43,6 +43,10 @@ void add_number_operations(Context& builder)
     builder.add_primitive("modulo", primitives::modulo);
     builder.add_primitive("remainder", primitives::remainder);
     builder.add_primitive("expt", primitives::exponential);
+    builder.add_primitive("exact-integer-expt-mod", primitives::exact_integer_expt_mod);
+    builder.add_primitive("factorial", primitives::factorial);
+    builder.add_primitive("binomial", primitives::binomial);
+    builder.add_primitive("product", primitives::product);
 }
 
 void add_number_utils(Context& builder)
@@ -63,10 +67,51 @@ void add_number_utils(Context& builder)
     builder.add_primitive("round", primitives::round);
 }
 
+void add_bitwise_operations(Context& builder)
+{
+    builder.add_primitive("bitwise-and", primitives::bitwise_and);
+    builder.add_primitive("bitwise-or", primitives::bitwise_or);
+    builder.add_primitive("bitwise-xor", primitives::bitwise_xor);
+    builder.add_primitive("bitwise-not", primitives::bitwise_not);
+    builder.add_primitive("arithmetic-shift", primitives::arithmetic_shift);
+    builder.add_primitive("bit-count", primitives::bit_count);
+    builder.add_primitive("integer-length", primitives::integer_length);
+}
+
+template <NumVector::Kind K>
+void add_numvector_kind(Context& builder)
+{
+    const auto name = NumVector::tag(K) + "vector";
+    builder.add_primitive("make-" + name, primitives::make_numvector<K>);
+    builder.add_primitive(name, primitives::numvector<K>);
+    builder.add_primitive(name + "?", primitives::is_numvector<K>);
+    builder.add_primitive(name + "-length", primitives::numvector_length<K>);
+    builder.add_primitive(name + "-ref", primitives::numvector_ref<K>);
+    builder.add_primitive(name + "-set!", primitives::numvector_set<K>);
+    builder.add_primitive(name + "->list", primitives::numvector_to_list<K>);
+    builder.add_primitive("list->" + name, primitives::list_to_numvector<K>);
+}
+
+void add_numvector_operations(Context& builder)
+{
+    add_numvector_kind<NumVector::Kind::F64>(builder);
+    add_numvector_kind<NumVector::Kind::S64>(builder);
+    add_numvector_kind<NumVector::Kind::U8>(builder);
+    builder.add_primitive("f64vector-sum", primitives::f64vector_sum);
+    builder.add_primitive("f64vector-dot", primitives::f64vector_dot);
+    builder.add_primitive("f64vector-add", primitives::f64vector_add);
+    builder.add_primitive("f64vector-mul", primitives::f64vector_mul);
+    builder.add_primitive("f64vector-scale", primitives::f64vector_scale);
+    builder.add_primitive("f64vector-min", primitives::f64vector_min);
+    builder.add_primitive("f64vector-max", primitives::f64vector_max);
+}
+
 void add_math_functions(Context& builder)
 {
     builder.add_primitive("sqrt", primitives::square_root);
     builder.add_primitive("isqrt", primitives::square_root_integer);
+    builder.add_primitive("exact-integer-sqrt", primitives::exact_integer_sqrt);
+    builder.add_primitive("exact-integer-root", primitives::exact_integer_root);
     builder.add_primitive("log", primitives::logarithm);
     builder.add_primitive("sin", primitives::sine);
     builder.add_primitive("cos", primitives::cosine);
@@ -188,6 +233,106 @@ void add_list_operations(Context& builder)
     builder.add_primitive("null?", primitives::is_null);
     builder.add_primitive("append", primitives::append);
     builder.add_primitive("length", primitives::length);
+    builder.add_primitive("map", primitives::map);
+    builder.add_primitive("for-each", primitives::for_each);
+    builder.add_primitive("filter", primitives::filter);
+    builder.add_primitive("fold-left", primitives::fold_left);
+    builder.add_primitive("fold-right", primitives::fold_right);
+    builder.add_primitive("reduce", primitives::reduce);
+    builder.add_primitive("sort", primitives::sort);
+    builder.add_primitive("sort!", primitives::sort_in_place);
+    builder.add_primitive("list-sort", primitives::list_sort);
+    builder.add_primitive("merge", primitives::merge);
+    builder.add_primitive("list-ref", primitives::list_ref);
+    builder.add_primitive("list-tail", primitives::list_tail);
+    builder.add_primitive("reverse", primitives::reverse);
+    builder.add_primitive("reverse!", primitives::reverse_in_place);
+    builder.add_primitive("last-pair", primitives::last_pair);
+    builder.add_primitive("list-copy", primitives::list_copy);
+    builder.add_primitive("memq", primitives::memq);
+    builder.add_primitive("memv", primitives::memv);
+    builder.add_primitive("member", primitives::member);
+    builder.add_primitive("assq", primitives::assq);
+    builder.add_primitive("assv", primitives::assv);
+    builder.add_primitive("assoc", primitives::assoc);
+}
+
+void add_vector_operations(Context& builder)
+{
+    builder.add_primitive("vector", primitives::vector_of);
+    builder.add_primitive("make-vector", primitives::make_vector);
+    builder.add_primitive("vector?", primitives::is_vector);
+    builder.add_primitive("vector-length", primitives::vector_length);
+    builder.add_primitive("vector-ref", primitives::vector_ref);
+    builder.add_primitive("vector-set!", primitives::vector_set);
+    builder.add_primitive("vector-fill!", primitives::vector_fill);
+    builder.add_primitive("vector->list", primitives::vector_to_list);
+    builder.add_primitive("list->vector", primitives::list_to_vector);
+}
+
+void add_hash_table_operations(Context& builder)
+{
+    builder.add_primitive("make-hash-table", primitives::make_hash_table);
+    builder.add_primitive("hash-table?", primitives::is_hash_table);
+    builder.add_primitive("hash-table-size", primitives::hash_table_size);
+    builder.add_primitive("hash-table-ref", primitives::hash_table_ref);
+    builder.add_primitive("hash-table-ref/default", primitives::hash_table_ref_default);
+    builder.add_primitive("hash-table-set!", primitives::hash_table_set);
+    builder.add_primitive("hash-table-delete!", primitives::hash_table_delete);
+    builder.add_primitive("hash-table-exists?", primitives::hash_table_exists);
+    builder.add_primitive("hash-table-update!", primitives::hash_table_update);
+    builder.add_primitive("hash-table-update!/default", primitives::hash_table_update_default);
+    builder.add_primitive("hash-table-walk", primitives::hash_table_walk);
+    builder.add_primitive("hash-table-fold", primitives::hash_table_fold);
+    builder.add_primitive("hash-table-keys", primitives::hash_table_keys);
+    builder.add_primitive("hash-table-values", primitives::hash_table_values);
+    builder.add_primitive("hash-table->alist", primitives::hash_table_to_alist);
+    builder.add_primitive("alist->hash-table", primitives::alist_to_hash_table);
+    builder.add_primitive("hash-table-copy", primitives::hash_table_copy);
+    builder.add_primitive("hash-table-clear!", primitives::hash_table_clear);
+    builder.add_primitive("hash-table-contains?", primitives::hash_table_exists);
+}
+
+void add_persistent_operations(Context& builder)
+{
+    builder.add_primitive("persistent-map", primitives::persistent_map);
+    builder.add_primitive("map?", primitives::is_persistent_map);
+    builder.add_primitive("map-ref", primitives::map_ref);
+    builder.add_primitive("map-assoc", primitives::map_assoc);
+    builder.add_primitive("map-dissoc", primitives::map_dissoc);
+    builder.add_primitive("map-contains?", primitives::map_contains);
+    builder.add_primitive("map-count", primitives::map_count);
+    builder.add_primitive("map-keys", primitives::map_keys);
+    builder.add_primitive("map-values", primitives::map_values);
+    builder.add_primitive("map->alist", primitives::map_to_alist);
+    builder.add_primitive("alist->map", primitives::alist_to_map);
+    builder.add_primitive("persistent-set", primitives::persistent_set);
+    builder.add_primitive("set?", primitives::is_persistent_set);
+    builder.add_primitive("set-add", primitives::set_add);
+    builder.add_primitive("set-remove", primitives::set_remove);
+    builder.add_primitive("set-contains?", primitives::set_contains);
+    builder.add_primitive("set-count", primitives::set_count);
+    builder.add_primitive("set->list", primitives::set_to_list);
+    builder.add_primitive("list->set", primitives::list_to_set);
+}
+
+void add_pvector_operations(Context& builder)
+{
+    builder.add_primitive("pvector", primitives::pvector);
+    builder.add_primitive("pvector?", primitives::is_pvector);
+    builder.add_primitive("pvector-length", primitives::pvector_length);
+    builder.add_primitive("pvector-ref", primitives::pvector_ref);
+    builder.add_primitive("pvector-set", primitives::pvector_set);
+    builder.add_primitive("pvector-push", primitives::pvector_push);
+    builder.add_primitive("pvector-append", primitives::pvector_append);
+    builder.add_primitive("pvector-slice", primitives::pvector_slice);
+    builder.add_primitive("pvector->list", primitives::pvector_to_list);
+    builder.add_primitive("list->pvector", primitives::list_to_pvector);
+}
+
+void add_record_operations(Context& builder)
+{
+    builder.add_primitive("define-record-type", primitives::define_record_type);
 }
 
 void add_eval_control(Context& builder)
@@ -226,6 +371,8 @@ shared_ptr<Context> make_root_context()
     add_number_comparators(*context);
     add_number_utils(*context);
     add_math_functions(*context);
+    add_bitwise_operations(*context);
+    add_numvector_operations(*context);
     add_type_utils(*context);
     add_logic_operations(*context);
     add_quote_operation(*context);
@@ -234,6 +381,11 @@ shared_ptr<Context> make_root_context()
     add_condition(*context);
     add_io_operations(*context);
     add_list_operations(*context);
+    add_vector_operations(*context);
+    add_hash_table_operations(*context);
+    add_persistent_operations(*context);
+    add_pvector_operations(*context);
+    add_record_operations(*context);
     add_eval_control(*context);
     add_mutable(*context);
     add_delay(*context);
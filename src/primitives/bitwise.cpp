@@ -0,0 +1,85 @@
+//
+// Created by glom on 11/3/25.
+//
+#include "error.h"
+#include "expr.h"
+#include "context.h"
+#include "primitive.h"
+
+using BitwiseStep = integer (integer::*)(const integer&) const;
+
+shared_ptr<Expr> expect_exact_integer(const string& proc, const shared_ptr<Context>& context, shared_ptr<Expr> expr)
+{
+    auto value = eval(context, std::move(expr));
+    if (!value->is_number_int())
+    {
+        throw GlomError("Invalid argument " + proc + ": " + value->to_string() + " is not a integer");
+    }
+    return value;
+}
+
+// Folds any number of exact integers, starting from the identity of the operation
+shared_ptr<Expr> fold_bitwise(const string& proc, const shared_ptr<Context>& context, const shared_ptr<Pair>& args,
+                              integer identity, const BitwiseStep step)
+{
+    integer result = std::move(identity);
+    for (const auto& expr : *args)
+    {
+        if (!expr) break;
+        const auto value = expect_exact_integer(proc, context, expr);
+        result = (result.*step)(value->as_number_int());
+    }
+    return Expr::make_number_int(std::move(result));
+}
+
+shared_ptr<Expr> primitives::bitwise_and(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    return fold_bitwise("bitwise-and", context, args, integer(-1), &integer::bitwise_and);
+}
+
+shared_ptr<Expr> primitives::bitwise_or(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    return fold_bitwise("bitwise-or", context, args, integer(0), &integer::bitwise_or);
+}
+
+shared_ptr<Expr> primitives::bitwise_xor(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    return fold_bitwise("bitwise-xor", context, args, integer(0), &integer::bitwise_xor);
+}
+
+shared_ptr<Expr> primitives::bitwise_not(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> expr = nullptr;
+    primitives_utils::expect_1_arg("bitwise-not", args, expr);
+    const auto value = expect_exact_integer("bitwise-not", context, std::move(expr));
+    return Expr::make_number_int(value->as_number_int().bitwise_not());
+}
+
+shared_ptr<Expr> primitives::arithmetic_shift(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> expr, shift_expr = nullptr;
+    primitives_utils::expect_2_args("arithmetic-shift", args, expr, shift_expr);
+    const auto value = expect_exact_integer("arithmetic-shift", context, std::move(expr));
+    const auto shift = expect_exact_integer("arithmetic-shift", context, std::move(shift_expr));
+    if (!shift->is_fixnum())
+    {
+        throw GlomError("Invalid argument arithmetic-shift: shift amount " + shift->to_string() + " is too large");
+    }
+    return Expr::make_number_int(value->as_number_int().arithmetic_shift(shift->as_fixnum()));
+}
+
+shared_ptr<Expr> primitives::bit_count(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> expr = nullptr;
+    primitives_utils::expect_1_arg("bit-count", args, expr);
+    const auto value = expect_exact_integer("bit-count", context, std::move(expr));
+    return Expr::make_number_int(integer(static_cast<int64_t>(value->as_number_int().bit_count())));
+}
+
+shared_ptr<Expr> primitives::integer_length(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> expr = nullptr;
+    primitives_utils::expect_1_arg("integer-length", args, expr);
+    const auto value = expect_exact_integer("integer-length", context, std::move(expr));
+    return Expr::make_number_int(integer(static_cast<int64_t>(value->as_number_int().integer_length())));
+}
@@ -101,9 +101,7 @@ shared_ptr<Expr> primitives::force(const shared_ptr<Context>& context, shared_pt
         throw GlomError("force: malformed promise (no thunk)");
     }
 
-    // Build application: (thunk)
-    const auto app = Expr::make_pair(Pair::cons(thunkOrVal, Expr::NIL));
-    auto value = eval(context, app);
+    auto value = apply_procedure(context, thunkOrVal, {});
 
     // Memoize: set forced? := #t, replace cell with computed value
     forcedPair->set_car(Expr::make_boolean(true));
@@ -7,6 +7,10 @@
 #include "expr.h"
 #include "primitive.h"
 
+#include <functional>
+#include <unordered_set>
+#include <utility>
+
 bool eq_ptr_impl(const shared_ptr<Expr>& a, const shared_ptr<Expr>& b) {
     if (a->get_type() != b->get_type()) return false;
     switch (a->get_type())
@@ -59,32 +63,108 @@ shared_ptr<Expr> primitives::eq_val(const shared_ptr<Context>& context, shared_p
     return Expr::make_boolean(equal_value_internal(a, b));
 }
 
-bool equal_struct_internal(const shared_ptr<Expr>& a, const shared_ptr<Expr>& b,
-                    unordered_map<const Expr*, const Expr*>& visited) {
+// Hashes a pairing of a node of a with a node of b
+struct NodePairingHash {
+    size_t operator()(const std::pair<const void*, const void*>& pairing) const {
+        return std::hash<const void*>()(pairing.first) * 31 ^ std::hash<const void*>()(pairing.second);
+    }
+};
+
+// Node pairings already under comparison: meeting one again, through a cycle or shared
+// structure, assumes it equal, while a node paired with a different counterpart is compared afresh
+using NodePairings = std::unordered_set<std::pair<const void*, const void*>, NodePairingHash>;
+
+bool equal_struct_internal(const shared_ptr<Expr>& a, const shared_ptr<Expr>& b, NodePairings& visited) {
     if (equal_value_internal(a,b)) return true;
     switch (a->get_type()) {
     case PAIR: {
-            const auto pa = a->as_pair();
-            const auto pb = b->as_pair();
-            if (!pa || !pb) return pa == pb; // both null -> equal; one null -> not equal
-            if (pa->empty() && pb->empty()) return true;
-            if (pa->empty() || pb->empty()) return false;
-            // cycle detection: if 'a' previously mapped it must map to 'b'
-            if (const auto it = visited.find(a.get()); it != visited.end()) return it->second == b.get();
-            visited[a.get()] = b.get();
-
-            if (!equal_struct_internal(pa->car(), pb->car(), visited)) return false;
-            if (!equal_struct_internal(pa->cdr(), pb->cdr(), visited)) return false;
-            return true;
+            if (!b->is_pair()) return false;
+            // Walk both spines side by side, recursing only into the cars
+            auto ca = a->as_pair_ref().walk();
+            auto cb = b->as_pair_ref().walk();
+            for (; !ca.done() && !cb.done(); ++ca, ++cb)
+            {
+                if (!visited.emplace(ca.pair(), cb.pair()).second) return true;
+                if (!equal_struct_internal(*ca, *cb, visited)) return false;
+            }
+            if (!ca.done() || !cb.done()) return false;
+            if (ca.tail()->is_nil() || cb.tail()->is_nil()) return ca.tail()->is_nil() && cb.tail()->is_nil();
+            return equal_struct_internal(ca.tail(), cb.tail(), visited);
     }
     case LAMBDA:
     case PRIMITIVE:
         return a.get() == b.get();
+    case NUMVECTOR:
+        return b->is_numvector() && *a->as_numvector() == *b->as_numvector();
+    case PERSISTENT_MAP: {
+            if (!b->is_persistent_map()) return false;
+            const auto& ma = a->as_persistent_map();
+            const auto& mb = b->as_persistent_map();
+            if (ma.size() != mb.size()) return false;
+            for (const auto& [key, value] : ma.entries())
+            {
+                const auto* other = mb.find(key);
+                if (!other || !equal_struct_internal(value, other->second, visited)) return false;
+            }
+            return true;
+    }
+    case PERSISTENT_SET: {
+            if (!b->is_persistent_set()) return false;
+            const auto& sa = a->as_persistent_set();
+            const auto& sb = b->as_persistent_set();
+            if (sa.size() != sb.size()) return false;
+            for (const auto& [key, _] : sa.entries())
+            {
+                if (!sb.find(key)) return false;
+            }
+            return true;
+    }
+    case PVECTOR: {
+            if (!b->is_pvector()) return false;
+            const auto& va = a->as_pvector();
+            const auto& vb = b->as_pvector();
+            if (va.size() != vb.size()) return false;
+            for (size_t i = 0; i < va.size(); ++i)
+            {
+                if (!equal_struct_internal(va.get(i), vb.get(i), visited)) return false;
+            }
+            return true;
+    }
+    case VECTOR: {
+            if (!b->is_vector()) return false;
+            const auto& va = *a->as_vector();
+            const auto& vb = *b->as_vector();
+            if (va.size() != vb.size()) return false;
+            // a vector may contain itself, so record the pairing before descending
+            if (!visited.emplace(a.get(), b.get()).second) return true;
+            for (size_t i = 0; i < va.size(); ++i)
+            {
+                if (!equal_struct_internal(va[i], vb[i], visited)) return false;
+            }
+            return true;
+    }
     default:
         return false;
     }
 }
 
+bool primitives_utils::is_eq(const shared_ptr<Expr>& a, const shared_ptr<Expr>& b)
+{
+    return eq_ptr_impl(a, b);
+}
+
+bool primitives_utils::is_eqv(const shared_ptr<Expr>& a, const shared_ptr<Expr>& b)
+{
+    return eq_ptr_impl(a, b) || equal_value_internal(a, b);
+}
+
+bool primitives_utils::is_equal(const shared_ptr<Expr>& a, const shared_ptr<Expr>& b)
+{
+    if (eq_ptr_impl(a, b)) return true;
+    NodePairings visited;
+    return equal_struct_internal(a, b, visited);
+}
+
 shared_ptr<Expr> primitives::eq_struct(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
 {
     shared_ptr<Expr> a, b = nullptr;
@@ -92,7 +172,7 @@ shared_ptr<Expr> primitives::eq_struct(const shared_ptr<Context>& context, share
     a = eval(context, a);
     b = eval(context, b);
     if (eq_ptr_impl(a,b)) return Expr::TRUE;
-    unordered_map<const Expr*, const Expr*> visited;
+    NodePairings visited;
     visited.reserve(32);
     return Expr::make_boolean(equal_struct_internal(a, b, visited));
 }
\ No newline at end of file
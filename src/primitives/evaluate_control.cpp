@@ -7,14 +7,28 @@
 #include "expr.h"
 #include "primitive.h"
 
+// (apply proc arg ... list): the leading args are prepended to the elements of list
 shared_ptr<Expr> primitives::apply(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
 {
-    shared_ptr<Expr> proc, proc_args;
-    primitives_utils::expect_2_args("apply", args, proc, proc_args);
-    proc = eval(context, proc);
-    proc_args = eval(context, proc_args);
-    const auto apply = Expr::make_pair(Pair::cons(proc,proc_args));
-    return eval(context, apply);
+    auto values = primitives_utils::eval_arguments(context, args);
+    if (values.size() < 2)
+    {
+        throw GlomError("Invalid number of arguments apply: at least 2 arguments required");
+    }
+    auto list = std::move(values.back());
+    values.pop_back();
+    while (!list->is_nil())
+    {
+        if (!list->is_pair())
+        {
+            throw GlomError("apply: last argument is not a list");
+        }
+        const auto pair = list->as_pair();
+        values.push_back(pair->car());
+        list = pair->cdr();
+    }
+    const auto proc = values.front();
+    return tail_apply_procedure(context, proc, std::span(values).subspan(1));
 }
 
 shared_ptr<Expr> primitives::callcc(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
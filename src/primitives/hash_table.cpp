@@ -0,0 +1,283 @@
+//
+// Created by glom on 11/7/25.
+//
+#include "error.h"
+#include "expr.h"
+#include "context.h"
+#include "hash_table.h"
+#include "primitive.h"
+
+using Equivalence = HashTable::Equivalence;
+
+shared_ptr<HashTable> expect_hash_table(const string& proc, const shared_ptr<Context>& context, shared_ptr<Expr> expr)
+{
+    const auto value = eval(context, std::move(expr));
+    if (!value->is_hash_table())
+    {
+        throw GlomError("Invalid argument " + proc + ": " + value->to_string() + " is not a hash table");
+    }
+    return value->as_hash_table();
+}
+
+// Only the builtin predicates are supported, each one selecting the hash that agrees with it
+Equivalence expect_equivalence(const string& proc, const shared_ptr<Expr>& expr)
+{
+    if (expr->is_primitive())
+    {
+        const auto& name = expr->as_primitive()->get_name();
+        if (name == "eq?")
+        {
+            return Equivalence::EQ;
+        }
+        if (name == "eqv?" || name == "=")
+        {
+            return Equivalence::EQV;
+        }
+        if (name == "equal?" || name == "string=?")
+        {
+            return Equivalence::EQUAL;
+        }
+    }
+    throw GlomError("Invalid argument " + proc + ": " + expr->to_string() + " is not eq?, eqv?, equal?, = or string=?");
+}
+
+// The optional equivalence argument (and any hash function after it) of a table constructor
+Equivalence equivalence_argument(const string& proc, const shared_ptr<Context>& context, const shared_ptr<Pair>& args)
+{
+    if (args->empty())
+    {
+        return Equivalence::EQUAL;
+    }
+    // A custom hash function is accepted but unused, the table always hashes to match its equivalence
+    shared_ptr<Expr> equivalence_expr, hash_expr = nullptr;
+    primitives_utils::expect_1_or_2_args(proc, args, equivalence_expr, hash_expr);
+    if (hash_expr)
+    {
+        eval(context, std::move(hash_expr));
+    }
+    return expect_equivalence(proc, eval(context, std::move(equivalence_expr)));
+}
+
+shared_ptr<Expr> primitives::make_hash_table(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    const auto equivalence = equivalence_argument("make-hash-table", context, args);
+    return Expr::make_hash_table(std::make_shared<HashTable>(equivalence));
+}
+
+shared_ptr<Expr> primitives::is_hash_table(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> expr = nullptr;
+    primitives_utils::expect_1_arg("hash-table?", args, expr);
+    expr = eval(context, std::move(expr));
+    return Expr::make_boolean(expr->is_hash_table());
+}
+
+shared_ptr<Expr> primitives::hash_table_size(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> expr = nullptr;
+    primitives_utils::expect_1_arg("hash-table-size", args, expr);
+    const auto table = expect_hash_table("hash-table-size", context, std::move(expr));
+    return Expr::make_number_int(integer(static_cast<int64_t>(table->size())));
+}
+
+shared_ptr<Expr> primitives::hash_table_ref(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> table_expr, key_expr, thunk_expr = nullptr;
+    primitives_utils::expect_2_or_3_args("hash-table-ref", args, table_expr, key_expr, thunk_expr);
+    const auto table = expect_hash_table("hash-table-ref", context, std::move(table_expr));
+    const auto key = eval(context, std::move(key_expr));
+    if (auto value = table->get(key))
+    {
+        return value;
+    }
+    if (!thunk_expr)
+    {
+        throw GlomError("hash-table-ref: no value for key " + key->to_string());
+    }
+    return apply_procedure(context, eval(context, std::move(thunk_expr)), {});
+}
+
+shared_ptr<Expr> primitives::hash_table_ref_default(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> table_expr, key_expr, default_expr = nullptr;
+    primitives_utils::expect_3_args("hash-table-ref/default", args, table_expr, key_expr, default_expr);
+    const auto table = expect_hash_table("hash-table-ref/default", context, std::move(table_expr));
+    if (auto value = table->get(eval(context, std::move(key_expr))))
+    {
+        return value;
+    }
+    return eval(context, std::move(default_expr));
+}
+
+shared_ptr<Expr> primitives::hash_table_set(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> table_expr, key_expr, value_expr = nullptr;
+    primitives_utils::expect_3_args("hash-table-set!", args, table_expr, key_expr, value_expr);
+    const auto table = expect_hash_table("hash-table-set!", context, std::move(table_expr));
+    const auto key = eval(context, std::move(key_expr));
+    table->set(key, eval(context, std::move(value_expr)));
+    return Expr::NOTHING;
+}
+
+shared_ptr<Expr> primitives::hash_table_delete(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> table_expr, key_expr = nullptr;
+    primitives_utils::expect_2_args("hash-table-delete!", args, table_expr, key_expr);
+    const auto table = expect_hash_table("hash-table-delete!", context, std::move(table_expr));
+    table->remove(eval(context, std::move(key_expr)));
+    return Expr::NOTHING;
+}
+
+shared_ptr<Expr> primitives::hash_table_exists(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> table_expr, key_expr = nullptr;
+    primitives_utils::expect_2_args("hash-table-exists?", args, table_expr, key_expr);
+    const auto table = expect_hash_table("hash-table-exists?", context, std::move(table_expr));
+    return Expr::make_boolean(table->get(eval(context, std::move(key_expr))) != nullptr);
+}
+
+// (hash-table-update! table key proc [thunk]) and (hash-table-update!/default table key proc default)
+shared_ptr<Expr> update_hash_table(const string& proc, const bool default_value, const shared_ptr<Context>& context,
+                                   const shared_ptr<Pair>& args)
+{
+    vector<shared_ptr<Expr>> exprs;
+    for (const auto& expr : *args)
+    {
+        if (!expr) break;
+        exprs.push_back(expr);
+    }
+    if (exprs.size() != 4 && (default_value || exprs.size() != 3))
+    {
+        throw GlomError("Invalid number of arguments " + proc + ": " + (default_value ? "exactly 4" : "3 or 4")
+                        + " arguments required");
+    }
+    const auto table = expect_hash_table(proc, context, exprs[0]);
+    const auto key = eval(context, exprs[1]);
+    const auto updater = eval(context, exprs[2]);
+    auto current = table->get(key);
+    if (!current)
+    {
+        if (exprs.size() == 3)
+        {
+            throw GlomError(proc + ": no value for key " + key->to_string());
+        }
+        current = default_value ? eval(context, exprs[3])
+                                : apply_procedure(context, eval(context, exprs[3]), {});
+    }
+    table->set(key, apply_procedure(context, updater, {&current, 1}));
+    return Expr::NOTHING;
+}
+
+shared_ptr<Expr> primitives::hash_table_update(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    return update_hash_table("hash-table-update!", false, context, args);
+}
+
+shared_ptr<Expr> primitives::hash_table_update_default(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    return update_hash_table("hash-table-update!/default", true, context, args);
+}
+
+shared_ptr<Expr> primitives::hash_table_walk(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> table_expr, proc_expr = nullptr;
+    primitives_utils::expect_2_args("hash-table-walk", args, table_expr, proc_expr);
+    const auto table = expect_hash_table("hash-table-walk", context, std::move(table_expr));
+    const auto proc = eval(context, std::move(proc_expr));
+    // Walks a snapshot, so the procedure may update the table
+    for (const auto& [key, value] : table->entries())
+    {
+        const shared_ptr<Expr> call_args[] = {key, value};
+        apply_procedure(context, proc, call_args);
+    }
+    return Expr::NOTHING;
+}
+
+shared_ptr<Expr> primitives::hash_table_fold(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> table_expr, proc_expr, seed_expr = nullptr;
+    primitives_utils::expect_3_args("hash-table-fold", args, table_expr, proc_expr, seed_expr);
+    const auto table = expect_hash_table("hash-table-fold", context, std::move(table_expr));
+    const auto proc = eval(context, std::move(proc_expr));
+    auto result = eval(context, std::move(seed_expr));
+    for (const auto& [key, value] : table->entries())
+    {
+        const shared_ptr<Expr> call_args[] = {key, value, std::move(result)};
+        result = apply_procedure(context, proc, call_args);
+    }
+    return result;
+}
+
+shared_ptr<Expr> hash_table_list(const string& proc, const shared_ptr<Context>& context, const shared_ptr<Pair>& args,
+                                 const std::function<shared_ptr<Expr>(const HashTable::Entry&)>& element)
+{
+    shared_ptr<Expr> expr = nullptr;
+    primitives_utils::expect_1_arg(proc, args, expr);
+    const auto table = expect_hash_table(proc, context, std::move(expr));
+    shared_ptr<Expr> list = Expr::NIL;
+    for (const auto& entry : table->entries())
+    {
+        list = Expr::make_pair(Pair::cons(element(entry), std::move(list)));
+    }
+    return list;
+}
+
+shared_ptr<Expr> primitives::hash_table_keys(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    return hash_table_list("hash-table-keys", context, args, [](const auto& entry) { return entry.first; });
+}
+
+shared_ptr<Expr> primitives::hash_table_values(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    return hash_table_list("hash-table-values", context, args, [](const auto& entry) { return entry.second; });
+}
+
+shared_ptr<Expr> primitives::hash_table_to_alist(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    return hash_table_list("hash-table->alist", context, args, [](const auto& entry)
+    {
+        return Expr::make_pair(Pair::cons(entry.first, entry.second));
+    });
+}
+
+shared_ptr<Expr> primitives::alist_to_hash_table(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    if (args->empty())
+    {
+        throw GlomError("alist->hash-table: expects 1 to 3 arguments, given 0");
+    }
+    const auto alist = eval(context, args->car());
+    const auto equivalence = equivalence_argument("alist->hash-table", context, args->cdr()->as_pair());
+    primitives_utils::expect_list("alist->hash-table", alist);
+    auto table = std::make_shared<HashTable>(equivalence);
+    for (const auto& entry : alist->as_pair_ref().walk())
+    {
+        if (!entry->is_pair() || entry->is_nil())
+        {
+            throw GlomError("Invalid argument alist->hash-table: " + entry->to_string() + " is not a pair");
+        }
+        // SRFI-69: the first association of a key wins
+        const auto pair = entry->as_pair();
+        if (!table->get(pair->car()))
+        {
+            table->set(pair->car(), pair->cdr());
+        }
+    }
+    return Expr::make_hash_table(std::move(table));
+}
+
+shared_ptr<Expr> primitives::hash_table_copy(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> expr = nullptr;
+    primitives_utils::expect_1_arg("hash-table-copy", args, expr);
+    const auto table = expect_hash_table("hash-table-copy", context, std::move(expr));
+    return Expr::make_hash_table(std::make_shared<HashTable>(*table));
+}
+
+shared_ptr<Expr> primitives::hash_table_clear(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> expr = nullptr;
+    primitives_utils::expect_1_arg("hash-table-clear!", args, expr);
+    expect_hash_table("hash-table-clear!", context, std::move(expr))->clear();
+    return Expr::NOTHING;
+}
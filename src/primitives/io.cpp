@@ -16,10 +16,10 @@ shared_ptr<Expr> primitives::display(const shared_ptr<Context>& context, shared_
     {
         throw GlomError("incorrect argument count in call display");
     }
-    for (auto expr : *args)
+    for (const auto& expr : *args)
     {
         if (!expr) break;
-        const auto arg = eval(context, std::move(expr));
+        const auto arg = eval(context, expr);
         printf("%s", arg->to_string().c_str());
     }
     return Expr::NOTHING;
@@ -5,6 +5,7 @@
 #include "error.h"
 #include "context.h"
 #include "expr.h"
+#include "list_builder.h"
 #include "primitive.h"
 
 shared_ptr<Expr> primitives::is_null(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
@@ -371,38 +372,23 @@ shared_ptr<Expr> primitives::cddddr(const shared_ptr<Context>& context, shared_p
 
 shared_ptr<Expr> primitives::list(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
 {
-    shared_ptr<Pair> list = nullptr;
-    shared_ptr<Pair> tail = nullptr;
-    for (auto elem_expr : *args)
+    ListBuilder list;
+    for (const auto& elem_expr : *args)
     {
         if (!elem_expr) break;
-        auto last = eval(context, std::move(elem_expr));
-        if (!list)
-        {
-            list = Pair::single(std::move(last));
-            tail = list;
-        }
-        else
-        {
-            const auto new_tail = Pair::single(std::move(last));
-            tail->set_cdr(Expr::make_pair(new_tail));
-            tail = new_tail;
-        }
+        list.push_back(eval(context, elem_expr));
     }
-    if (!list)
-        return Expr::NIL;
-    return Expr::make_pair(list);
+    return list.build();
 }
 
 //append
 shared_ptr<Expr> primitives::append(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
 {
-    shared_ptr<Pair> result = nullptr;
-    shared_ptr<Pair> tail = nullptr;
-    for (auto list_expr : *args)
+    ListBuilder result;
+    for (const auto& list_expr : *args)
     {
         if (!list_expr) break;
-        const auto list = eval(context, std::move(list_expr));
+        const auto list = eval(context, list_expr);
         if (list->is_nil())
         {
             continue;
@@ -411,26 +397,12 @@ shared_ptr<Expr> primitives::append(const shared_ptr<Context>& context, shared_p
         {
             throw GlomError("append: argument is not a list: " + list->to_string());
         }
-        auto current = list->as_pair()->begin();
-        while (*current != nullptr)
+        for (const auto& element : list->as_pair_ref())
         {
-            auto elem = std::move(*current++);
-            if (!result)
-            {
-                result = Pair::single(std::move(elem));
-                tail = result;
-            }
-            else
-            {
-                const auto new_tail = Pair::single(std::move(elem));
-                tail->set_cdr(Expr::make_pair(new_tail));
-                tail = new_tail;
-            }
+            result.push_back(element);
         }
     }
-    if (!result)
-        return Expr::NIL;
-    return Expr::make_pair(result);
+    return result.build();
 }
 
 // length
@@ -447,12 +419,433 @@ shared_ptr<Expr> primitives::length(const shared_ptr<Context>& context, shared_p
     {
         throw GlomError("length: argument is not a list: " + list_expr->to_string());
     }
-    const auto list = list_expr->as_pair();
     int64_t len = 0;
-    for (const auto& _ : *list)
+    for (auto it = list_expr->as_pair_ref().begin(); *it; ++it)
     {
-        if (!_ ) break;
         len++;
     }
     return Expr::make_number_int(integer(len));
-}
\ No newline at end of file
+}
+// Steps every list forward by one element into heads; false once any of them runs out
+bool next_elements(const string& proc, vector<shared_ptr<Expr>>& lists, vector<shared_ptr<Expr>>& heads)
+{
+    for (size_t i = 0; i < lists.size(); ++i)
+    {
+        if (lists[i]->is_nil())
+        {
+            return false;
+        }
+        if (!lists[i]->is_pair())
+        {
+            throw GlomError(proc + ": argument is not a list: " + lists[i]->to_string());
+        }
+        const auto pair = lists[i]->as_pair();
+        heads[i] = pair->car();
+        lists[i] = pair->cdr();
+    }
+    return true;
+}
+
+// Evaluates (proc list1 list2 ...) style arguments, starting the lists at first
+vector<shared_ptr<Expr>> expect_procedure_and_lists(const string& proc, const shared_ptr<Context>& context,
+                                                    const shared_ptr<Pair>& args, const size_t first)
+{
+    auto values = primitives_utils::eval_arguments(context, args);
+    if (values.size() <= first)
+    {
+        throw GlomError("Invalid number of arguments " + proc + ": at least " + std::to_string(first + 1) +
+                        " arguments required");
+    }
+    return values;
+}
+
+// map
+shared_ptr<Expr> primitives::map(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    auto values = expect_procedure_and_lists("map", context, args, 1);
+    vector lists(values.begin() + 1, values.end());
+    vector<shared_ptr<Expr>> heads(lists.size());
+    ListBuilder result;
+    while (next_elements("map", lists, heads))
+    {
+        result.push_back(apply_procedure(context, values[0], heads));
+    }
+    return result.build();
+}
+
+// for-each
+shared_ptr<Expr> primitives::for_each(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    auto values = expect_procedure_and_lists("for-each", context, args, 1);
+    vector lists(values.begin() + 1, values.end());
+    vector<shared_ptr<Expr>> heads(lists.size());
+    while (next_elements("for-each", lists, heads))
+    {
+        apply_procedure(context, values[0], heads);
+    }
+    return Expr::NOTHING;
+}
+
+// filter
+shared_ptr<Expr> primitives::filter(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> pred, list = nullptr;
+    primitives_utils::expect_2_args("filter", args, pred, list);
+    pred = eval(context, pred);
+    vector lists{eval(context, list)};
+    vector<shared_ptr<Expr>> heads(1);
+    ListBuilder result;
+    while (next_elements("filter", lists, heads))
+    {
+        if (apply_procedure(context, pred, heads)->to_boolean())
+        {
+            result.push_back(heads[0]);
+        }
+    }
+    return result.build();
+}
+
+// fold-left: (proc acc elem1 elem2 ...) from the front
+shared_ptr<Expr> primitives::fold_left(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    auto values = expect_procedure_and_lists("fold-left", context, args, 2);
+    vector lists(values.begin() + 2, values.end());
+    vector<shared_ptr<Expr>> heads(lists.size());
+    vector<shared_ptr<Expr>> call_args(lists.size() + 1);
+    auto acc = values[1];
+    while (next_elements("fold-left", lists, heads))
+    {
+        call_args[0] = std::move(acc);
+        std::copy(heads.begin(), heads.end(), call_args.begin() + 1);
+        acc = apply_procedure(context, values[0], call_args);
+    }
+    return acc;
+}
+
+// fold-right: (proc elem1 elem2 ... acc) from the back
+shared_ptr<Expr> primitives::fold_right(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    auto values = expect_procedure_and_lists("fold-right", context, args, 2);
+    vector lists(values.begin() + 2, values.end());
+    vector<shared_ptr<Expr>> heads(lists.size());
+    vector<vector<shared_ptr<Expr>>> rows;
+    while (next_elements("fold-right", lists, heads))
+    {
+        rows.push_back(heads);
+    }
+    auto acc = values[1];
+    for (auto it = rows.rbegin(); it != rows.rend(); ++it)
+    {
+        it->push_back(std::move(acc));
+        acc = apply_procedure(context, values[0], *it);
+    }
+    return acc;
+}
+
+// reduce: (proc elem acc), seeded with the first element; ridentity only for the empty list
+shared_ptr<Expr> primitives::reduce(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> proc, identity, list = nullptr;
+    primitives_utils::expect_3_args("reduce", args, proc, identity, list);
+    proc = eval(context, proc);
+    vector lists{eval(context, list)};
+    vector<shared_ptr<Expr>> heads(1);
+    if (!next_elements("reduce", lists, heads))
+    {
+        return eval(context, identity);
+    }
+    auto acc = std::move(heads[0]);
+    vector<shared_ptr<Expr>> call_args(2);
+    while (next_elements("reduce", lists, heads))
+    {
+        call_args[0] = std::move(heads[0]);
+        call_args[1] = std::move(acc);
+        acc = apply_procedure(context, proc, call_args);
+    }
+    return acc;
+}
+
+// The pair list starts with; the empty list or any other value is not one
+const Pair& expect_pair(const string& proc, const shared_ptr<Expr>& list)
+{
+    if (!list->is_pair() || list->is_nil())
+    {
+        throw GlomError(proc + ": argument is not a pair: " + list->to_string());
+    }
+    return list->as_pair_ref();
+}
+
+// A cursor k pairs into list
+Pair::cursor advance(const string& proc, const shared_ptr<Expr>& list, const size_t k)
+{
+    auto cursor = expect_pair(proc, list).walk();
+    for (size_t i = 0; i < k && !cursor.done(); ++i)
+    {
+        ++cursor;
+    }
+    if (cursor.done())
+    {
+        throw GlomError("Invalid argument " + proc + ": index " + std::to_string(k) + " is out of range");
+    }
+    return cursor;
+}
+
+// list-ref: (list-ref list k)
+shared_ptr<Expr> primitives::list_ref(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> list, index = nullptr;
+    primitives_utils::expect_2_args("list-ref", args, list, index);
+    list = eval(context, std::move(list));
+    const auto k = primitives_utils::expect_index("list-ref", context, std::move(index), SIZE_MAX);
+    return *advance("list-ref", list, k);
+}
+
+// list-tail: (list-tail list k), sharing the pairs of list
+shared_ptr<Expr> primitives::list_tail(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> list, index = nullptr;
+    primitives_utils::expect_2_args("list-tail", args, list, index);
+    list = eval(context, std::move(list));
+    const auto k = primitives_utils::expect_index("list-tail", context, std::move(index), SIZE_MAX);
+    if (k == 0)
+    {
+        return list;
+    }
+    return advance("list-tail", list, k - 1).pair()->cdr();
+}
+
+// reverse
+shared_ptr<Expr> primitives::reverse(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> list = nullptr;
+    primitives_utils::expect_1_arg("reverse", args, list);
+    list = eval(context, std::move(list));
+    shared_ptr<Expr> result = Expr::NIL;
+    primitives_utils::expect_list("reverse", list);
+    for (const auto& element : list->as_pair_ref().walk())
+    {
+        result = Expr::make_pair(Pair::cons(element, std::move(result)));
+    }
+    return result;
+}
+
+// reverse!: relinks the pairs of the list itself and returns the new first pair
+shared_ptr<Expr> primitives::reverse_in_place(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> list = nullptr;
+    primitives_utils::expect_1_arg("reverse!", args, list);
+    list = eval(context, std::move(list));
+    primitives_utils::expect_list("reverse!", list);
+    shared_ptr<Expr> result = Expr::NIL;
+    while (!list->is_nil())
+    {
+        const auto pair = list->as_pair();
+        auto next = pair->cdr();
+        pair->set_cdr(std::move(result));
+        result = std::move(list);
+        list = std::move(next);
+    }
+    return result;
+}
+
+// last-pair
+shared_ptr<Expr> primitives::last_pair(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> list = nullptr;
+    primitives_utils::expect_1_arg("last-pair", args, list);
+    list = eval(context, std::move(list));
+    auto cursor = expect_pair("last-pair", list).walk();
+    const Pair* before_last = nullptr;
+    const Pair* last = cursor.pair();
+    while (!(++cursor).done())
+    {
+        before_last = last;
+        last = cursor.pair();
+    }
+    return before_last ? before_last->cdr() : list;
+}
+
+// list-copy: a fresh spine over the same elements; an improper tail and non-lists are kept as they are
+shared_ptr<Expr> primitives::list_copy(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> list = nullptr;
+    primitives_utils::expect_1_arg("list-copy", args, list);
+    list = eval(context, std::move(list));
+    if (!list->is_pair() || list->is_nil())
+    {
+        return list;
+    }
+    ListBuilder copy;
+    auto cursor = list->as_pair_ref().walk();
+    for (; !cursor.done(); ++cursor)
+    {
+        copy.push_back(*cursor);
+    }
+    if (!cursor.tail()->is_nil())
+    {
+        copy.set_tail(cursor.tail());
+    }
+    return copy.build();
+}
+
+// The first sublist of list whose car satisfies matches, or false. The pairs are borrowed, so
+// matches must not run Scheme code.
+template <typename Matches>
+shared_ptr<Expr> find_member(const string& proc, const shared_ptr<Expr>& list, Matches matches)
+{
+    if (!list->is_pair())
+    {
+        throw GlomError(proc + ": argument is not a list: " + list->to_string());
+    }
+    const Pair* previous = nullptr;
+    auto cursor = list->as_pair_ref().walk();
+    for (; !cursor.done(); ++cursor)
+    {
+        if (matches(*cursor))
+        {
+            return previous ? previous->cdr() : list;
+        }
+        previous = cursor.pair();
+    }
+    if (!cursor.tail()->is_nil())
+    {
+        throw GlomError(proc + ": argument is not a list: " + list->to_string());
+    }
+    return Expr::FALSE;
+}
+
+// The first pair of alist whose car satisfies matches, or false; borrows like find_member
+template <typename Matches>
+shared_ptr<Expr> find_association(const string& proc, const shared_ptr<Expr>& alist, Matches matches)
+{
+    if (!alist->is_pair())
+    {
+        throw GlomError(proc + ": argument is not a list: " + alist->to_string());
+    }
+    auto cursor = alist->as_pair_ref().walk();
+    for (; !cursor.done(); ++cursor)
+    {
+        const auto& entry = *cursor;
+        if (!entry->is_pair() || entry->is_nil())
+        {
+            throw GlomError(proc + ": element is not a pair: " + entry->to_string());
+        }
+        if (matches(entry->as_pair_ref().car()))
+        {
+            return entry;
+        }
+    }
+    if (!cursor.tail()->is_nil())
+    {
+        throw GlomError(proc + ": argument is not a list: " + alist->to_string());
+    }
+    return Expr::FALSE;
+}
+
+// As find_member and find_association, but with a Scheme procedure comparing (compare key x).
+// Each pair is held while it runs, so the procedure may modify the list.
+shared_ptr<Expr> find_calling(const string& proc, const shared_ptr<Context>& context, const shared_ptr<Expr>& key,
+                              const shared_ptr<Expr>& list, const shared_ptr<Expr>& compare, const bool association)
+{
+    shared_ptr<Expr> call_args[] = {key, nullptr};
+    for (auto current = list; !current->is_nil(); current = current->as_pair_ref().cdr())
+    {
+        if (!current->is_pair())
+        {
+            throw GlomError(proc + ": argument is not a list: " + list->to_string());
+        }
+        const auto element = current->as_pair_ref().car();
+        if (association && (!element->is_pair() || element->is_nil()))
+        {
+            throw GlomError(proc + ": element is not a pair: " + element->to_string());
+        }
+        call_args[1] = association ? element->as_pair_ref().car() : element;
+        if (apply_procedure(context, compare, call_args)->to_boolean())
+        {
+            return association ? element : current;
+        }
+    }
+    return Expr::FALSE;
+}
+
+// Runs find with an eq? test against key; interned symbols are eq? exactly when their names share storage
+template <typename Find>
+shared_ptr<Expr> find_eq(const shared_ptr<Expr>& key, Find find)
+{
+    if (key->is_symbol())
+    {
+        const auto name = key->as_symbol().data();
+        return find([name](const shared_ptr<Expr>& x) { return x->is_symbol() && x->as_symbol().data() == name; });
+    }
+    return find([&key](const shared_ptr<Expr>& x) { return primitives_utils::is_eq(key, x); });
+}
+
+// memq
+shared_ptr<Expr> primitives::memq(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> key, list = nullptr;
+    primitives_utils::expect_2_args("memq", args, key, list);
+    key = eval(context, std::move(key));
+    list = eval(context, std::move(list));
+    return find_eq(key, [&](auto matches) { return find_member("memq", list, matches); });
+}
+
+// memv
+shared_ptr<Expr> primitives::memv(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> key, list = nullptr;
+    primitives_utils::expect_2_args("memv", args, key, list);
+    key = eval(context, std::move(key));
+    list = eval(context, std::move(list));
+    return find_member("memv", list, [&key](const shared_ptr<Expr>& x) { return primitives_utils::is_eqv(key, x); });
+}
+
+// member: (member obj list [compare])
+shared_ptr<Expr> primitives::member(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> key, list, compare = nullptr;
+    primitives_utils::expect_2_or_3_args("member", args, key, list, compare);
+    key = eval(context, std::move(key));
+    list = eval(context, std::move(list));
+    if (compare)
+    {
+        return find_calling("member", context, key, list, eval(context, std::move(compare)), false);
+    }
+    return find_member("member", list, [&key](const shared_ptr<Expr>& x) { return primitives_utils::is_equal(key, x); });
+}
+
+// assq
+shared_ptr<Expr> primitives::assq(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> key, alist = nullptr;
+    primitives_utils::expect_2_args("assq", args, key, alist);
+    key = eval(context, std::move(key));
+    alist = eval(context, std::move(alist));
+    return find_eq(key, [&](auto matches) { return find_association("assq", alist, matches); });
+}
+
+// assv
+shared_ptr<Expr> primitives::assv(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> key, alist = nullptr;
+    primitives_utils::expect_2_args("assv", args, key, alist);
+    key = eval(context, std::move(key));
+    alist = eval(context, std::move(alist));
+    return find_association("assv", alist,
+                            [&key](const shared_ptr<Expr>& x) { return primitives_utils::is_eqv(key, x); });
+}
+
+// assoc: (assoc obj alist [compare])
+shared_ptr<Expr> primitives::assoc(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> key, alist, compare = nullptr;
+    primitives_utils::expect_2_or_3_args("assoc", args, key, alist, compare);
+    key = eval(context, std::move(key));
+    alist = eval(context, std::move(alist));
+    if (compare)
+    {
+        return find_calling("assoc", context, key, alist, eval(context, std::move(compare)), true);
+    }
+    return find_association("assoc", alist,
+                            [&key](const shared_ptr<Expr>& x) { return primitives_utils::is_equal(key, x); });
+}
@@ -9,10 +9,10 @@
 
 shared_ptr<Expr> primitives::logical_and(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
 {
-    for (auto expr : *args)
+    for (const auto& expr : *args)
     {
         if (!expr) break;
-        if (!eval(context, std::move(expr))->to_boolean())
+        if (!eval(context, expr)->to_boolean())
         {
             return Expr::FALSE;
         }
@@ -21,10 +21,10 @@ shared_ptr<Expr> primitives::logical_and(const shared_ptr<Context>& context, sha
 }
 shared_ptr<Expr> primitives::logical_or(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
 {
-    for (auto expr : *args)
+    for (const auto& expr : *args)
     {
         if (!expr) break;
-        if (eval(context, std::move(expr))->to_boolean())
+        if (eval(context, expr)->to_boolean())
         {
             return Expr::TRUE;
         }
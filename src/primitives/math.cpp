@@ -357,4 +357,55 @@ shared_ptr<Expr> primitives::square_root_integer(const shared_ptr<Context>& cont
         throw GlomError("Invalid argument isqrt: cannot compute square root of negative integer");
     }
     return Expr::make_number_int(value.isqrt());
-}
\ No newline at end of file
+}
+shared_ptr<Expr> make_root_and_remainder(integer root, integer remainder)
+{
+    auto rest = Expr::make_pair(Pair::single(Expr::make_number_int(std::move(remainder))));
+    return Expr::make_pair(Pair::cons(Expr::make_number_int(std::move(root)), std::move(rest)));
+}
+
+// exact-integer-sqrt: (root remainder) with n = root^2 + remainder
+shared_ptr<Expr> primitives::exact_integer_sqrt(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> value_expr = nullptr;
+    primitives_utils::expect_1_arg("exact-integer-sqrt", args, value_expr);
+    value_expr = eval(context, std::move(value_expr));
+    if (!value_expr->is_number_int())
+    {
+        throw GlomError("Invalid argument exact-integer-sqrt: " + value_expr->to_string() + " is not a integer");
+    }
+    const auto& value = value_expr->as_number_int();
+    if (value.is_negative())
+    {
+        throw GlomError("Invalid argument exact-integer-sqrt: cannot compute square root of negative integer");
+    }
+    auto root = value.isqrt();
+    auto remainder = value - root * root;
+    return make_root_and_remainder(std::move(root), std::move(remainder));
+}
+
+// exact-integer-root: (root remainder) with n = root^k + remainder, the root truncated toward zero
+shared_ptr<Expr> primitives::exact_integer_root(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> value_expr, k_expr = nullptr;
+    primitives_utils::expect_2_args("exact-integer-root", args, value_expr, k_expr);
+    value_expr = eval(context, std::move(value_expr));
+    k_expr = eval(context, std::move(k_expr));
+    if (!value_expr->is_number_int())
+    {
+        throw GlomError("Invalid argument exact-integer-root: " + value_expr->to_string() + " is not a integer");
+    }
+    if (!k_expr->is_fixnum() || k_expr->as_fixnum() < 1)
+    {
+        throw GlomError("Invalid argument exact-integer-root: " + k_expr->to_string() + " is not a positive integer");
+    }
+    const auto& value = value_expr->as_number_int();
+    const auto k = static_cast<uint64_t>(k_expr->as_fixnum());
+    if (value.is_negative() && k % 2 == 0)
+    {
+        throw GlomError("Invalid argument exact-integer-root: cannot compute even root of negative integer");
+    }
+    auto root = value.iroot(k);
+    auto remainder = value - root.pow(integer(static_cast<int64_t>(k)));
+    return make_root_and_remainder(std::move(root), std::move(remainder));
+}
@@ -1,6 +1,7 @@
 //
 // Created by glom on 9/27/25.
 //
+#include "accumulator.h"
 #include "error.h"
 #include "expr.h"
 #include "context.h"
@@ -8,72 +9,17 @@
 
 bool primitives_utils::generic_num_eq(shared_ptr<Expr>& a, shared_ptr<Expr>& b)
 {
-    coerce_number(a,b);
-    if (a->is_number_real())
-    {
-        return a->as_number_real() == b->as_number_real();
-    }
-    if (a->is_number_rat())
-    {
-        return a->as_number_rat() == b->as_number_rat();
-    }
-    return a->as_number_int() == b->as_number_int();
+    return compare_numbers(*a, *b) == 0;
 }
 
 bool primitives_utils::generic_num_lt(shared_ptr<Expr>& a, shared_ptr<Expr>& b)
 {
-    coerce_number(a,b);
-    if (a->is_number_real())
-    {
-        return a->as_number_real() < b->as_number_real();
-    }
-    if (a->is_number_rat())
-    {
-        return a->as_number_rat() < b->as_number_rat();
-    }
-    return a->as_number_int() < b->as_number_int();
+    return compare_numbers(*a, *b) < 0;
 }
 
 bool primitives_utils::generic_num_gt(shared_ptr<Expr>& a, shared_ptr<Expr>& b)
 {
-    coerce_number(a,b);
-    if (a->is_number_real())
-    {
-        return a->as_number_real() > b->as_number_real();
-    }
-    if (a->is_number_rat())
-    {
-        return a->as_number_rat() > b->as_number_rat();
-    }
-    return a->as_number_int() > b->as_number_int();
-}
-
-bool generic_le(shared_ptr<Expr>& a, shared_ptr<Expr>& b)
-{
-    primitives_utils::coerce_number(a,b);
-    if (a->is_number_real())
-    {
-        return a->as_number_real() <= b->as_number_real();
-    }
-    if (a->is_number_rat())
-    {
-        return a->as_number_rat() <= b->as_number_rat();
-    }
-    return a->as_number_int() <= b->as_number_int();
-}
-
-bool generic_ge(shared_ptr<Expr>& a, shared_ptr<Expr>& b)
-{
-    primitives_utils::coerce_number(a,b);
-    if (a->is_number_real())
-    {
-        return a->as_number_real() >= b->as_number_real();
-    }
-    if (a->is_number_rat())
-    {
-        return a->as_number_rat() >= b->as_number_rat();
-    }
-    return a->as_number_int() >= b->as_number_int();
+    return compare_numbers(*a, *b) > 0;
 }
 
 shared_ptr<Expr> primitives::eq(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
@@ -89,7 +35,7 @@ shared_ptr<Expr> primitives::eq(const shared_ptr<Context>& context, shared_ptr<P
     }
     const auto rest = args->cdr()->as_pair();
     auto first = first_expr;
-    for (const auto it: *rest)
+    for (const auto& it : *rest)
     {
         if (!it) break;
         auto next_expr = eval(context, it);
@@ -97,7 +43,7 @@ shared_ptr<Expr> primitives::eq(const shared_ptr<Context>& context, shared_ptr<P
         {
             throw GlomError("Invalid argument =: " + next_expr->to_string() + " is not a number");
         }
-        if (!primitives_utils::generic_num_eq(first, next_expr))
+        if (compare_numbers(*first, *next_expr) != 0)
         {
             return Expr::FALSE;
         }
@@ -117,7 +63,7 @@ shared_ptr<Expr> primitives::lt(const shared_ptr<Context>& context, shared_ptr<P
     }
     const auto rest = args->cdr()->as_pair();
     auto last = first;
-    for (const auto it: *rest)
+    for (const auto& it : *rest)
     {
         if (!it) break;
         auto next_expr = eval(context, it);
@@ -125,7 +71,7 @@ shared_ptr<Expr> primitives::lt(const shared_ptr<Context>& context, shared_ptr<P
         {
             throw GlomError("Invalid argument <: " + next_expr->to_string() + " is not a number");
         }
-        if (generic_ge(last, next_expr))
+        if (!(compare_numbers(*last, *next_expr) < 0))
         {
             return Expr::FALSE;
         }
@@ -146,7 +92,7 @@ shared_ptr<Expr> primitives::gt(const shared_ptr<Context>& context, shared_ptr<P
     }
     const auto rest = args->cdr()->as_pair();
     auto last = first;
-    for (const auto it: *rest)
+    for (const auto& it : *rest)
     {
         if (!it) break;
          auto next_expr = eval(context, it);
@@ -155,7 +101,7 @@ shared_ptr<Expr> primitives::gt(const shared_ptr<Context>& context, shared_ptr<P
         {
             throw GlomError("Invalid argument >: " + next_expr->to_string() + " is not a number");
         }
-        if (generic_le(last, next_expr))
+        if (!(compare_numbers(*last, *next_expr) > 0))
         {
             return Expr::FALSE;
         }
@@ -177,7 +123,7 @@ shared_ptr<Expr> primitives::le(const shared_ptr<Context>& context, shared_ptr<P
     }
     const auto rest = args->cdr()->as_pair();
     auto last = first;
-    for (const auto it: *rest)
+    for (const auto& it : *rest)
     {
         if (!it) break;
         auto next_expr = eval(context, it);
@@ -186,7 +132,7 @@ shared_ptr<Expr> primitives::le(const shared_ptr<Context>& context, shared_ptr<P
         {
             throw GlomError("Invalid argument <=: " + next_expr->to_string() + " is not a number");
         }
-        if (primitives_utils::generic_num_gt(last, next_expr))
+        if (!(compare_numbers(*last, *next_expr) <= 0))
         {
             return Expr::FALSE;
         }
@@ -207,7 +153,7 @@ shared_ptr<Expr> primitives::ge(const shared_ptr<Context>& context, shared_ptr<P
     }
     const auto rest = args->cdr()->as_pair();
     auto last = first;
-    for (const auto it: *rest)
+    for (const auto& it : *rest)
     {
         if (!it) break;
         auto next_expr = eval(context, it);
@@ -216,7 +162,7 @@ shared_ptr<Expr> primitives::ge(const shared_ptr<Context>& context, shared_ptr<P
         {
             throw GlomError("Invalid argument >=: " + next_expr->to_string() + " is not a number");
         }
-        if (primitives_utils::generic_num_lt(last, next_expr))
+        if (!(compare_numbers(*last, *next_expr) >= 0))
         {
             return Expr::FALSE;
         }
@@ -3,56 +3,12 @@
 //
 #include <cmath>
 
+#include "accumulator.h"
 #include "context.h"
 #include "error.h"
 #include "expr.h"
 #include "primitive.h"
 
-shared_ptr<Expr> generic_add(shared_ptr<Expr>& a, shared_ptr<Expr>& b)
-{
-    primitives_utils::coerce_number(a, b);
-    if (a->is_number_real())
-    {
-        return Expr::make_number_real(a->as_number_real() + b->as_number_real());
-    }
-    if (a->is_number_rat())
-    {
-        auto result = a->as_number_rat() + b->as_number_rat();
-        return Expr::make_number_exact(std::move(result));
-    }
-    return Expr::make_number_int(a->as_number_int() + b->as_number_int());
-}
-
-shared_ptr<Expr> generic_sub(shared_ptr<Expr>& a, shared_ptr<Expr>& b)
-{
-    primitives_utils::coerce_number(a, b);
-    if (a->is_number_real())
-    {
-        return Expr::make_number_real(a->as_number_real() - b->as_number_real());
-    }
-    if (a->is_number_rat())
-    {
-        auto result = a->as_number_rat() - b->as_number_rat();
-        return Expr::make_number_exact(std::move(result));
-    }
-    return Expr::make_number_int(a->as_number_int() - b->as_number_int());
-}
-
-shared_ptr<Expr> generic_mul(shared_ptr<Expr>& a, shared_ptr<Expr>& b)
-{
-    primitives_utils::coerce_number(a, b);
-    if (a->is_number_real())
-    {
-        return Expr::make_number_real(a->as_number_real() * b->as_number_real());
-    }
-    if (a->is_number_rat())
-    {
-        auto result = a->as_number_rat() * b->as_number_rat();
-        return Expr::make_number_exact(std::move(result));
-    }
-    return Expr::make_number_int(a->as_number_int() * b->as_number_int());
-}
-
 shared_ptr<Expr> generic_div(shared_ptr<Expr>& a, shared_ptr<Expr>& b)
 {
     primitives_utils::coerce_number(a, b);
@@ -72,20 +28,6 @@ shared_ptr<Expr> generic_div(shared_ptr<Expr>& a, shared_ptr<Expr>& b)
     return Expr::make_number_exact(std::move(result));
 }
 
-shared_ptr<Expr> generic_neg(const shared_ptr<Expr>& a)
-{
-    if (a->is_number_real())
-    {
-        return Expr::make_number_real(-a->as_number_real());
-    }
-    if (a->is_number_rat())
-    {
-        auto result = -a->as_number_rat();
-        return Expr::make_number_exact(std::move(result));
-    }
-    return Expr::make_number_int(-a->as_number_int());
-}
-
 shared_ptr<Expr> generic_reciprocal(const shared_ptr<Expr>& a)
 {
     if (a->is_number_real())
@@ -119,7 +61,7 @@ shared_ptr<Expr> pow(const shared_ptr<Expr>& a, const shared_ptr<Expr>& b)
 {
     if (a->is_number_real() || b->is_number_real())
     {
-        return Expr::make_number_real(std::powl(a->to_number_real(), b->to_number_real()));
+        return Expr::make_number_real(std::pow(a->to_number_real(), b->to_number_real()));
     }
     integer exp;
     if (b->is_number_rat())
@@ -127,7 +69,7 @@ shared_ptr<Expr> pow(const shared_ptr<Expr>& a, const shared_ptr<Expr>& b)
         const auto rat_exp = b->as_number_rat();
         if (!rat_exp.is_integer())
         {
-            return Expr::make_number_real(std::powl(a->to_number_real(), rat_exp.to_inexact()));
+            return Expr::make_number_real(std::pow(a->to_number_real(), rat_exp.to_inexact()));
         }
         exp = rat_exp.num;
     } else
@@ -146,6 +88,24 @@ shared_ptr<Expr> pow(const shared_ptr<Expr>& a, const shared_ptr<Expr>& b)
     return Expr::make_number_exact(std::move(result));
 }
 
+// Folds the remaining arguments into `acc` without boxing any intermediate result
+template <void (NumberAccumulator::*Step)(const Expr&)>
+shared_ptr<Expr> fold_numbers(const shared_ptr<Context>& context, NumberAccumulator& acc, const shared_ptr<Pair>& rest,
+                              const string& name)
+{
+    for (const auto& expr : *rest)
+    {
+        if (!expr) break;
+        const auto arg = eval(context, expr);
+        if (!arg->is_number())
+        {
+            throw GlomError("Invalid argument " + name + ": " + arg->to_string());
+        }
+        (acc.*Step)(*arg);
+    }
+    return acc.box();
+}
+
 shared_ptr<Expr> primitives::add(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
 {
     if (args->empty())
@@ -153,24 +113,13 @@ shared_ptr<Expr> primitives::add(const shared_ptr<Context>& context, shared_ptr<
         return Expr::make_number_int(integer(0));
     }
 
-    shared_ptr<Expr> sum = nullptr;
-
-    for (auto expr : *args)
+    auto first = eval(context, args->car());
+    if (!first->is_number())
     {
-        if (!expr) break;
-        auto arg = eval(context, std::move(expr));
-        if (!arg->is_number())
-        {
-            throw GlomError("Invalid argument +: " + arg->to_string());
-        }
-        if (!sum)
-        {
-            sum = arg;
-            continue;
-        }
-        sum = generic_add(sum, arg);
+        throw GlomError("Invalid argument +: " + first->to_string());
     }
-    return sum;
+    NumberAccumulator acc(*first);
+    return fold_numbers<&NumberAccumulator::add>(context, acc, args->cdr()->as_pair(), "+");
 }
 shared_ptr<Expr> primitives::sub(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
 {
@@ -183,22 +132,13 @@ shared_ptr<Expr> primitives::sub(const shared_ptr<Context>& context, shared_ptr<
     {
         throw GlomError("Invalid argument -: " + minuend_expr->to_string());
     }
+    NumberAccumulator acc(*minuend_expr);
     if (args->cdr()->is_nil())
     {
-        return generic_neg(minuend_expr);
-    }
-    shared_ptr<Expr> minuend = minuend_expr;
-    for (const auto subtrahends = args->cdr()->as_pair(); auto expr : *subtrahends)
-    {
-        if (!expr) break;
-        auto arg = eval(context, std::move(expr));
-        if (!arg->is_number())
-        {
-            throw GlomError("Invalid argument -: " + arg->to_string());
-        }
-        minuend = generic_sub(minuend, arg);
+        acc.negate();
+        return acc.box();
     }
-    return minuend;
+    return fold_numbers<&NumberAccumulator::sub>(context, acc, args->cdr()->as_pair(), "-");
 }
 shared_ptr<Expr> primitives::mul(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
 {
@@ -207,23 +147,13 @@ shared_ptr<Expr> primitives::mul(const shared_ptr<Context>& context, shared_ptr<
         return Expr::make_number_int(integer(1));
     }
 
-    shared_ptr<Expr> product = nullptr;
-    for (auto expr : *args)
+    auto first = eval(context, args->car());
+    if (!first->is_number())
     {
-        if (!expr) break;
-        auto arg = eval(context, std::move(expr));
-        if (!arg->is_number())
-        {
-            throw GlomError("Invalid argument *: " + arg->to_string());
-        }
-        if (!product)
-        {
-            product = arg;
-            continue;
-        }
-        product = generic_mul(product, arg);
+        throw GlomError("Invalid argument *: " + first->to_string());
     }
-    return product;
+    NumberAccumulator acc(*first);
+    return fold_numbers<&NumberAccumulator::mul>(context, acc, args->cdr()->as_pair(), "*");
 }
 shared_ptr<Expr> primitives::div(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
 {
@@ -266,8 +196,8 @@ shared_ptr<Expr> primitives::quotient(const shared_ptr<Context>& context, shared
     {
         throw GlomError("quotient only support integer numbers");
     }
-    const integer dividend = a->as_number_int();
-    const integer divisor = b->as_number_int();
+    const integer& dividend = a->as_number_int();
+    const integer& divisor = b->as_number_int();
     if (divisor.is_zero())
     {
         throw GlomError("quotient undefined for 0");
@@ -287,8 +217,8 @@ shared_ptr<Expr> primitives::remainder(const shared_ptr<Context>& context, share
     {
         throw GlomError("remainder only support integer numbers");
     }
-    const integer dividend = a->as_number_int();
-    const integer divisor = b->as_number_int();
+    const integer& dividend = a->as_number_int();
+    const integer& divisor = b->as_number_int();
     if (divisor.is_zero())
     {
         throw GlomError("remainder undefined for 0");
@@ -308,8 +238,8 @@ shared_ptr<Expr> primitives::modulo(const shared_ptr<Context>& context, shared_p
     {
         throw GlomError("modulo only support integer numbers");
     }
-    const integer dividend = a->as_number_int();
-    const integer divisor = b->as_number_int();
+    const integer& dividend = a->as_number_int();
+    const integer& divisor = b->as_number_int();
     if (divisor.is_zero())
     {
         throw GlomError("modulo undefined for 0");
@@ -330,4 +260,93 @@ shared_ptr<Expr> primitives::exponential(const shared_ptr<Context>& context, sha
         throw GlomError("Invalid argument expt: both arguments must be numbers");
     }
     return pow(base_expr, exp_expr);
-}
\ No newline at end of file
+}
+shared_ptr<Expr> primitives::exact_integer_expt_mod(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> base_expr, exp_expr, mod_expr = nullptr;
+    primitives_utils::expect_3_args("exact-integer-expt-mod", args, base_expr, exp_expr, mod_expr);
+    base_expr = eval(context, std::move(base_expr));
+    exp_expr = eval(context, std::move(exp_expr));
+    mod_expr = eval(context, std::move(mod_expr));
+    if (!base_expr->is_number_int() || !exp_expr->is_number_int() || !mod_expr->is_number_int())
+    {
+        throw GlomError("exact-integer-expt-mod only support integer numbers");
+    }
+    const auto& exponent = exp_expr->as_number_int();
+    const auto& modulus = mod_expr->as_number_int();
+    if (exponent.is_negative())
+    {
+        throw GlomError("Invalid argument exact-integer-expt-mod: exponent must be non-negative");
+    }
+    if (!modulus.is_positive())
+    {
+        throw GlomError("Invalid argument exact-integer-expt-mod: modulus must be positive");
+    }
+    return Expr::make_number_int(base_expr->as_number_int().expt_mod(exponent, modulus));
+}
+
+uint64_t expect_non_negative_fixnum(const string& proc, const shared_ptr<Context>& context, shared_ptr<Expr> expr)
+{
+    const auto value = eval(context, std::move(expr));
+    if (!value->is_fixnum() || value->as_fixnum() < 0)
+    {
+        throw GlomError("Invalid argument " + proc + ": " + value->to_string() + " is not a non-negative integer");
+    }
+    return static_cast<uint64_t>(value->as_fixnum());
+}
+
+shared_ptr<Expr> primitives::factorial(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> n_expr = nullptr;
+    primitives_utils::expect_1_arg("factorial", args, n_expr);
+    const auto n = expect_non_negative_fixnum("factorial", context, std::move(n_expr));
+    return Expr::make_number_int(integer::factorial(n));
+}
+
+shared_ptr<Expr> primitives::binomial(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> n_expr, k_expr = nullptr;
+    primitives_utils::expect_2_args("binomial", args, n_expr, k_expr);
+    const auto n = expect_non_negative_fixnum("binomial", context, std::move(n_expr));
+    const auto k = expect_non_negative_fixnum("binomial", context, std::move(k_expr));
+    return Expr::make_number_int(integer::binomial(n, k));
+}
+
+// product: multiplies a list of numbers, through a balanced product tree when all are exact integers
+shared_ptr<Expr> primitives::product(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> list_expr = nullptr;
+    primitives_utils::expect_1_arg("product", args, list_expr);
+    const auto list = eval(context, std::move(list_expr));
+    if (list->is_nil())
+    {
+        return Expr::make_number_int(integer(1));
+    }
+    primitives_utils::expect_list("product", list);
+    std::vector<integer> factors;
+    for (const auto& elem : *list->as_pair())
+    {
+        if (!elem) break;
+        if (!elem->is_number())
+        {
+            throw GlomError("Invalid argument product: " + elem->to_string() + " is not a number");
+        }
+        if (!elem->is_number_int())
+        {
+            // Rationals and reals take the generic path with the usual contagion
+            NumberAccumulator acc(*Expr::make_number_int(integer(1)));
+            for (const auto& number : *list->as_pair())
+            {
+                if (!number) break;
+                if (!number->is_number())
+                {
+                    throw GlomError("Invalid argument product: " + number->to_string() + " is not a number");
+                }
+                acc.mul(*number);
+            }
+            return acc.box();
+        }
+        factors.push_back(elem->as_number_int());
+    }
+    return Expr::make_number_int(integer::product(std::move(factors)));
+}
@@ -3,6 +3,7 @@
 //
 #include <cmath>
 
+#include "accumulator.h"
 #include "error.h"
 #include "expr.h"
 #include "context.h"
@@ -157,7 +158,8 @@ shared_ptr<Expr> primitives::max(const shared_ptr<Context>& context, shared_ptr<
     }
     const auto rest = args->cdr()->as_pair();
     auto first = first_expr;
-    for (const auto it: *rest)
+    bool inexact = first->is_number_real();
+    for (const auto& it : *rest)
     {
         if (!it) break;
         auto next_expr = eval(context, it);
@@ -165,11 +167,17 @@ shared_ptr<Expr> primitives::max(const shared_ptr<Context>& context, shared_ptr<
         {
             throw GlomError("Invalid argument max: " + next_expr->to_string() + " is not a number");
         }
-        if (primitives_utils::generic_num_gt(next_expr,first))
+        inexact = inexact || next_expr->is_number_real();
+        if (compare_numbers(*next_expr, *first) > 0)
         {
             first = next_expr;
         }
     }
+    // If any argument is inexact, so is the result
+    if (inexact && !first->is_number_real())
+    {
+        return Expr::make_number_real(first->to_number_real());
+    }
     return first;
 }
 
@@ -187,7 +195,8 @@ shared_ptr<Expr> primitives::min(const shared_ptr<Context>& context, shared_ptr<
     }
     const auto rest = args->cdr()->as_pair();
     auto first = first_expr;
-    for (const auto it: *rest)
+    bool inexact = first->is_number_real();
+    for (const auto& it : *rest)
     {
         if (!it) break;
         auto next_expr = eval(context, it);
@@ -195,11 +204,17 @@ shared_ptr<Expr> primitives::min(const shared_ptr<Context>& context, shared_ptr<
         {
             throw GlomError("Invalid argument min: " + next_expr->to_string() + " is not a number");
         }
-        if (primitives_utils::generic_num_lt(next_expr,first))
+        inexact = inexact || next_expr->is_number_real();
+        if (compare_numbers(*next_expr, *first) < 0)
         {
             first = next_expr;
         }
     }
+    // If any argument is inexact, so is the result
+    if (inexact && !first->is_number_real())
+    {
+        return Expr::make_number_real(first->to_number_real());
+    }
     return first;
 }
 
@@ -240,7 +255,7 @@ shared_ptr<Expr> primitives::gcd(const shared_ptr<Context>& context, shared_ptr<
     }
     const auto rest = args->cdr()->as_pair();
     auto result = first_expr->as_number_int().abs();
-    for (const auto it: *rest)
+    for (const auto& it : *rest)
     {
         if (!it) break;
         const auto next_expr = eval(context, it);
@@ -268,7 +283,7 @@ shared_ptr<Expr> primitives::lcm(const shared_ptr<Context>& context, shared_ptr<
     }
     const auto rest = args->cdr()->as_pair();
     auto result = first_expr->as_number_int().abs();
-    for (const auto it: *rest)
+    for (const auto& it : *rest)
     {
         if (!it) break;
         const auto next_expr = eval(context, it);
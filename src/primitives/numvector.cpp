@@ -0,0 +1,301 @@
+//
+// Created by glom on 11/6/25.
+//
+#include "error.h"
+#include "expr.h"
+#include "context.h"
+#include "numvector.h"
+#include "primitive.h"
+
+using Kind = NumVector::Kind;
+
+// Element type of each kind, with the conversions to and from Exprs
+template <Kind K>
+struct NumVectorElement;
+
+template <>
+struct NumVectorElement<Kind::F64>
+{
+    using type = double;
+
+    static std::vector<double>& of(NumVector& vector) { return vector.f64(); }
+
+    static double from_expr(const string& proc, const Expr& expr)
+    {
+        if (!expr.is_number())
+        {
+            throw GlomError("Invalid argument " + proc + ": " + expr.to_string() + " is not a real number");
+        }
+        return static_cast<double>(expr.to_number_real());
+    }
+
+    static shared_ptr<Expr> to_expr(const double value) { return Expr::make_number_real(f64_to_real(value)); }
+};
+
+template <>
+struct NumVectorElement<Kind::S64>
+{
+    using type = int64_t;
+
+    static std::vector<int64_t>& of(NumVector& vector) { return vector.s64(); }
+
+    static int64_t from_expr(const string& proc, const Expr& expr)
+    {
+        if (!expr.is_fixnum())
+        {
+            throw GlomError("Invalid argument " + proc + ": " + expr.to_string() + " is not a 64-bit integer");
+        }
+        return expr.as_fixnum();
+    }
+
+    static shared_ptr<Expr> to_expr(const int64_t value) { return Expr::make_number_int(integer(value)); }
+};
+
+template <>
+struct NumVectorElement<Kind::U8>
+{
+    using type = uint8_t;
+
+    static std::vector<uint8_t>& of(NumVector& vector) { return vector.u8(); }
+
+    static uint8_t from_expr(const string& proc, const Expr& expr)
+    {
+        if (!expr.is_fixnum() || expr.as_fixnum() < 0 || expr.as_fixnum() > 255)
+        {
+            throw GlomError("Invalid argument " + proc + ": " + expr.to_string() + " is not a byte");
+        }
+        return static_cast<uint8_t>(expr.as_fixnum());
+    }
+
+    static shared_ptr<Expr> to_expr(const uint8_t value) { return Expr::make_number_int(integer(value)); }
+};
+
+template <Kind K>
+string numvector_proc(const string& suffix)
+{
+    return NumVector::tag(K) + "vector" + suffix;
+}
+
+template <Kind K>
+shared_ptr<NumVector> expect_numvector(const string& proc, const shared_ptr<Context>& context, shared_ptr<Expr> expr)
+{
+    const auto value = eval(context, std::move(expr));
+    if (!value->is_numvector() || value->as_numvector()->kind() != K)
+    {
+        throw GlomError("Invalid argument " + proc + ": " + value->to_string() + " is not a " + numvector_proc<K>(""));
+    }
+    return value->as_numvector();
+}
+
+template <Kind K>
+shared_ptr<Expr> primitives::make_numvector(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    using Element = NumVectorElement<K>;
+    const auto proc = "make-" + numvector_proc<K>("");
+    shared_ptr<Expr> size_expr, fill_expr = nullptr;
+    primitives_utils::expect_1_or_2_args(proc, args, size_expr, fill_expr);
+    size_expr = eval(context, std::move(size_expr));
+    if (!size_expr->is_fixnum() || size_expr->as_fixnum() < 0)
+    {
+        throw GlomError("Invalid argument " + proc + ": " + size_expr->to_string() + " is not a valid size");
+    }
+    auto vector = std::make_shared<NumVector>(K, static_cast<size_t>(size_expr->as_fixnum()));
+    if (fill_expr)
+    {
+        const auto fill = Element::from_expr(proc, *eval(context, std::move(fill_expr)));
+        std::ranges::fill(Element::of(*vector), fill);
+    }
+    return Expr::make_numvector(std::move(vector));
+}
+
+template <Kind K>
+shared_ptr<Expr> primitives::numvector(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    using Element = NumVectorElement<K>;
+    std::vector<typename Element::type> values;
+    for (const auto& expr : *args)
+    {
+        if (!expr) break;
+        values.push_back(Element::from_expr(numvector_proc<K>(""), *eval(context, expr)));
+    }
+    return Expr::make_numvector(std::make_shared<NumVector>(std::move(values)));
+}
+
+template <Kind K>
+shared_ptr<Expr> primitives::is_numvector(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> expr = nullptr;
+    primitives_utils::expect_1_arg(numvector_proc<K>("?"), args, expr);
+    expr = eval(context, std::move(expr));
+    return Expr::make_boolean(expr->is_numvector() && expr->as_numvector()->kind() == K);
+}
+
+template <Kind K>
+shared_ptr<Expr> primitives::numvector_length(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    const auto proc = numvector_proc<K>("-length");
+    shared_ptr<Expr> expr = nullptr;
+    primitives_utils::expect_1_arg(proc, args, expr);
+    const auto vector = expect_numvector<K>(proc, context, std::move(expr));
+    return Expr::make_number_int(integer(static_cast<int64_t>(vector->size())));
+}
+
+template <Kind K>
+shared_ptr<Expr> primitives::numvector_ref(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    using Element = NumVectorElement<K>;
+    const auto proc = numvector_proc<K>("-ref");
+    shared_ptr<Expr> vector_expr, index_expr = nullptr;
+    primitives_utils::expect_2_args(proc, args, vector_expr, index_expr);
+    const auto vector = expect_numvector<K>(proc, context, std::move(vector_expr));
+    const auto index = primitives_utils::expect_index(proc, context, std::move(index_expr), vector->size());
+    return Element::to_expr(Element::of(*vector)[index]);
+}
+
+template <Kind K>
+shared_ptr<Expr> primitives::numvector_set(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    using Element = NumVectorElement<K>;
+    const auto proc = numvector_proc<K>("-set!");
+    shared_ptr<Expr> vector_expr, index_expr, value_expr = nullptr;
+    primitives_utils::expect_3_args(proc, args, vector_expr, index_expr, value_expr);
+    const auto vector = expect_numvector<K>(proc, context, std::move(vector_expr));
+    const auto index = primitives_utils::expect_index(proc, context, std::move(index_expr), vector->size());
+    Element::of(*vector)[index] = Element::from_expr(proc, *eval(context, std::move(value_expr)));
+    return Expr::NOTHING;
+}
+
+template <Kind K>
+shared_ptr<Expr> primitives::numvector_to_list(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    using Element = NumVectorElement<K>;
+    const auto proc = numvector_proc<K>("->list");
+    shared_ptr<Expr> expr = nullptr;
+    primitives_utils::expect_1_arg(proc, args, expr);
+    const auto vector = expect_numvector<K>(proc, context, std::move(expr));
+    const auto& values = Element::of(*vector);
+    shared_ptr<Expr> list = Expr::NIL;
+    for (size_t i = values.size(); i > 0; --i)
+    {
+        list = Expr::make_pair(Pair::cons(Element::to_expr(values[i - 1]), std::move(list)));
+    }
+    return list;
+}
+
+template <Kind K>
+shared_ptr<Expr> primitives::list_to_numvector(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    using Element = NumVectorElement<K>;
+    const auto proc = "list->" + numvector_proc<K>("");
+    shared_ptr<Expr> expr = nullptr;
+    primitives_utils::expect_1_arg(proc, args, expr);
+    const auto list = eval(context, std::move(expr));
+    primitives_utils::expect_list(proc, list);
+    std::vector<typename Element::type> values;
+    for (const auto& element : list->as_pair_ref().walk())
+    {
+        values.push_back(Element::from_expr(proc, *element));
+    }
+    return Expr::make_numvector(std::make_shared<NumVector>(std::move(values)));
+}
+
+#define GLOM_INSTANTIATE_NUMVECTOR(K)                                                                           \
+    template shared_ptr<Expr> primitives::make_numvector<K>(const shared_ptr<Context>&, shared_ptr<Pair>&&);     \
+    template shared_ptr<Expr> primitives::numvector<K>(const shared_ptr<Context>&, shared_ptr<Pair>&&);          \
+    template shared_ptr<Expr> primitives::is_numvector<K>(const shared_ptr<Context>&, shared_ptr<Pair>&&);       \
+    template shared_ptr<Expr> primitives::numvector_length<K>(const shared_ptr<Context>&, shared_ptr<Pair>&&);   \
+    template shared_ptr<Expr> primitives::numvector_ref<K>(const shared_ptr<Context>&, shared_ptr<Pair>&&);      \
+    template shared_ptr<Expr> primitives::numvector_set<K>(const shared_ptr<Context>&, shared_ptr<Pair>&&);      \
+    template shared_ptr<Expr> primitives::numvector_to_list<K>(const shared_ptr<Context>&, shared_ptr<Pair>&&);  \
+    template shared_ptr<Expr> primitives::list_to_numvector<K>(const shared_ptr<Context>&, shared_ptr<Pair>&&);
+
+GLOM_INSTANTIATE_NUMVECTOR(Kind::F64)
+GLOM_INSTANTIATE_NUMVECTOR(Kind::S64)
+GLOM_INSTANTIATE_NUMVECTOR(Kind::U8)
+
+// Bulk f64vector kernels
+
+shared_ptr<Expr> primitives::f64vector_sum(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> expr = nullptr;
+    primitives_utils::expect_1_arg("f64vector-sum", args, expr);
+    const auto vector = expect_numvector<Kind::F64>("f64vector-sum", context, std::move(expr));
+    return Expr::make_number_real(f64_to_real(numvector_kernels::sum(vector->f64().data(), vector->size())));
+}
+
+shared_ptr<Expr> primitives::f64vector_dot(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> a_expr, b_expr = nullptr;
+    primitives_utils::expect_2_args("f64vector-dot", args, a_expr, b_expr);
+    const auto a = expect_numvector<Kind::F64>("f64vector-dot", context, std::move(a_expr));
+    const auto b = expect_numvector<Kind::F64>("f64vector-dot", context, std::move(b_expr));
+    if (a->size() != b->size())
+    {
+        throw GlomError("Invalid argument f64vector-dot: vectors differ in length");
+    }
+    return Expr::make_number_real(f64_to_real(numvector_kernels::dot(a->f64().data(), b->f64().data(), a->size())));
+}
+
+using ElementwiseKernel = void (*)(double*, const double*, const double*, size_t);
+
+shared_ptr<Expr> f64vector_elementwise(const string& proc, const ElementwiseKernel kernel,
+                                       const shared_ptr<Context>& context, const shared_ptr<Pair>& args)
+{
+    shared_ptr<Expr> a_expr, b_expr = nullptr;
+    primitives_utils::expect_2_args(proc, args, a_expr, b_expr);
+    const auto a = expect_numvector<Kind::F64>(proc, context, std::move(a_expr));
+    const auto b = expect_numvector<Kind::F64>(proc, context, std::move(b_expr));
+    if (a->size() != b->size())
+    {
+        throw GlomError("Invalid argument " + proc + ": vectors differ in length");
+    }
+    auto result = std::make_shared<NumVector>(Kind::F64, a->size());
+    kernel(result->f64().data(), a->f64().data(), b->f64().data(), a->size());
+    return Expr::make_numvector(std::move(result));
+}
+
+shared_ptr<Expr> primitives::f64vector_add(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    return f64vector_elementwise("f64vector-add", numvector_kernels::add, context, args);
+}
+
+shared_ptr<Expr> primitives::f64vector_mul(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    return f64vector_elementwise("f64vector-mul", numvector_kernels::mul, context, args);
+}
+
+shared_ptr<Expr> primitives::f64vector_scale(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> vector_expr, factor_expr = nullptr;
+    primitives_utils::expect_2_args("f64vector-scale", args, vector_expr, factor_expr);
+    const auto vector = expect_numvector<Kind::F64>("f64vector-scale", context, std::move(vector_expr));
+    const auto factor = NumVectorElement<Kind::F64>::from_expr("f64vector-scale", *eval(context, std::move(factor_expr)));
+    auto result = std::make_shared<NumVector>(Kind::F64, vector->size());
+    numvector_kernels::scale(result->f64().data(), vector->f64().data(), factor, vector->size());
+    return Expr::make_numvector(std::move(result));
+}
+
+using ReductionKernel = double (*)(const double*, size_t);
+
+shared_ptr<Expr> f64vector_extremum(const string& proc, const ReductionKernel kernel,
+                                    const shared_ptr<Context>& context, const shared_ptr<Pair>& args)
+{
+    shared_ptr<Expr> expr = nullptr;
+    primitives_utils::expect_1_arg(proc, args, expr);
+    const auto vector = expect_numvector<Kind::F64>(proc, context, std::move(expr));
+    if (vector->size() == 0)
+    {
+        throw GlomError("Invalid argument " + proc + ": empty vector");
+    }
+    return Expr::make_number_real(f64_to_real(kernel(vector->f64().data(), vector->size())));
+}
+
+shared_ptr<Expr> primitives::f64vector_min(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    return f64vector_extremum("f64vector-min", numvector_kernels::min, context, args);
+}
+
+shared_ptr<Expr> primitives::f64vector_max(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    return f64vector_extremum("f64vector-max", numvector_kernels::max, context, args);
+}
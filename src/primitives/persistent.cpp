@@ -0,0 +1,264 @@
+//
+// Created by glom on 11/7/25.
+//
+#include <functional>
+
+#include "error.h"
+#include "expr.h"
+#include "context.h"
+#include "hamt.h"
+#include "primitive.h"
+
+const PersistentMap& expect_persistent_map(const string& proc, const shared_ptr<Expr>& value)
+{
+    if (!value->is_persistent_map())
+    {
+        throw GlomError("Invalid argument " + proc + ": " + value->to_string() + " is not a map");
+    }
+    return value->as_persistent_map();
+}
+
+const PersistentSet& expect_persistent_set(const string& proc, const shared_ptr<Expr>& value)
+{
+    if (!value->is_persistent_set())
+    {
+        throw GlomError("Invalid argument " + proc + ": " + value->to_string() + " is not a set");
+    }
+    return value->as_persistent_set();
+}
+
+// Binds alternating keys and values from first onwards
+Hamt assoc_pairs(const string& proc, Hamt map, const vector<shared_ptr<Expr>>& values, const size_t first)
+{
+    if ((values.size() - first) % 2 != 0)
+    {
+        throw GlomError("Invalid number of arguments " + proc + ": keys and values must come in pairs");
+    }
+    for (size_t i = first; i < values.size(); i += 2)
+    {
+        map = map.assoc(values[i], values[i + 1]);
+    }
+    return map;
+}
+
+shared_ptr<Expr> primitives::persistent_map(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    const auto values = primitives_utils::eval_arguments(context, args);
+    return Expr::make_persistent_map(PersistentMap(assoc_pairs("persistent-map", Hamt(), values, 0)));
+}
+
+shared_ptr<Expr> primitives::is_persistent_map(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> expr = nullptr;
+    primitives_utils::expect_1_arg("map?", args, expr);
+    return Expr::make_boolean(eval(context, std::move(expr))->is_persistent_map());
+}
+
+shared_ptr<Expr> primitives::map_ref(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> map_expr, key_expr, default_expr = nullptr;
+    primitives_utils::expect_2_or_3_args("map-ref", args, map_expr, key_expr, default_expr);
+    const auto map_value = eval(context, std::move(map_expr));
+    const auto& map = expect_persistent_map("map-ref", map_value);
+    const auto key = eval(context, std::move(key_expr));
+    if (const auto* entry = map.find(key))
+    {
+        return entry->second;
+    }
+    if (!default_expr)
+    {
+        throw GlomError("map-ref: no value for key " + key->to_string());
+    }
+    return eval(context, std::move(default_expr));
+}
+
+shared_ptr<Expr> primitives::map_assoc(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    const auto values = primitives_utils::eval_arguments(context, args);
+    if (values.empty())
+    {
+        throw GlomError("Invalid number of arguments map-assoc: a map is required");
+    }
+    const auto& map = expect_persistent_map("map-assoc", values[0]);
+    return Expr::make_persistent_map(PersistentMap(assoc_pairs("map-assoc", map, values, 1)));
+}
+
+shared_ptr<Expr> primitives::map_dissoc(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    const auto values = primitives_utils::eval_arguments(context, args);
+    if (values.empty())
+    {
+        throw GlomError("Invalid number of arguments map-dissoc: a map is required");
+    }
+    Hamt map = expect_persistent_map("map-dissoc", values[0]);
+    for (size_t i = 1; i < values.size(); ++i)
+    {
+        map = map.dissoc(values[i]);
+    }
+    return Expr::make_persistent_map(PersistentMap(std::move(map)));
+}
+
+shared_ptr<Expr> primitives::map_contains(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> map_expr, key_expr = nullptr;
+    primitives_utils::expect_2_args("map-contains?", args, map_expr, key_expr);
+    const auto map_value = eval(context, std::move(map_expr));
+    const auto& map = expect_persistent_map("map-contains?", map_value);
+    return Expr::make_boolean(map.find(eval(context, std::move(key_expr))) != nullptr);
+}
+
+shared_ptr<Expr> primitives::map_count(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> expr = nullptr;
+    primitives_utils::expect_1_arg("map-count", args, expr);
+    const auto map_value = eval(context, std::move(expr));
+    const auto& map = expect_persistent_map("map-count", map_value);
+    return Expr::make_number_int(integer(static_cast<int64_t>(map.size())));
+}
+
+shared_ptr<Expr> map_list(const string& proc, const shared_ptr<Context>& context, const shared_ptr<Pair>& args,
+                          const std::function<shared_ptr<Expr>(const Hamt::Entry&)>& element)
+{
+    shared_ptr<Expr> expr = nullptr;
+    primitives_utils::expect_1_arg(proc, args, expr);
+    const auto map_value = eval(context, std::move(expr));
+    shared_ptr<Expr> list = Expr::NIL;
+    for (const auto& entry : expect_persistent_map(proc, map_value).entries())
+    {
+        list = Expr::make_pair(Pair::cons(element(entry), std::move(list)));
+    }
+    return list;
+}
+
+shared_ptr<Expr> primitives::map_keys(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    return map_list("map-keys", context, args, [](const auto& entry) { return entry.first; });
+}
+
+shared_ptr<Expr> primitives::map_values(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    return map_list("map-values", context, args, [](const auto& entry) { return entry.second; });
+}
+
+shared_ptr<Expr> primitives::map_to_alist(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    return map_list("map->alist", context, args, [](const auto& entry)
+    {
+        return Expr::make_pair(Pair::cons(entry.first, entry.second));
+    });
+}
+
+shared_ptr<Expr> primitives::alist_to_map(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> expr = nullptr;
+    primitives_utils::expect_1_arg("alist->map", args, expr);
+    const auto alist = eval(context, std::move(expr));
+    primitives_utils::expect_list("alist->map", alist);
+    Hamt map;
+    for (const auto& entry : alist->as_pair_ref().walk())
+    {
+        if (!entry->is_pair() || entry->is_nil())
+        {
+            throw GlomError("Invalid argument alist->map: " + entry->to_string() + " is not a pair");
+        }
+        // Like assoc, the first association of a key wins
+        const auto pair = entry->as_pair();
+        if (!map.find(pair->car()))
+        {
+            map = map.assoc(pair->car(), pair->cdr());
+        }
+    }
+    return Expr::make_persistent_map(PersistentMap(std::move(map)));
+}
+
+shared_ptr<Expr> primitives::persistent_set(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    Hamt set;
+    for (const auto& value : primitives_utils::eval_arguments(context, args))
+    {
+        set = set.assoc(value, nullptr);
+    }
+    return Expr::make_persistent_set(PersistentSet(std::move(set)));
+}
+
+shared_ptr<Expr> primitives::is_persistent_set(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> expr = nullptr;
+    primitives_utils::expect_1_arg("set?", args, expr);
+    return Expr::make_boolean(eval(context, std::move(expr))->is_persistent_set());
+}
+
+shared_ptr<Expr> primitives::set_add(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    const auto values = primitives_utils::eval_arguments(context, args);
+    if (values.empty())
+    {
+        throw GlomError("Invalid number of arguments set-add: a set is required");
+    }
+    Hamt set = expect_persistent_set("set-add", values[0]);
+    for (size_t i = 1; i < values.size(); ++i)
+    {
+        set = set.assoc(values[i], nullptr);
+    }
+    return Expr::make_persistent_set(PersistentSet(std::move(set)));
+}
+
+shared_ptr<Expr> primitives::set_remove(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    const auto values = primitives_utils::eval_arguments(context, args);
+    if (values.empty())
+    {
+        throw GlomError("Invalid number of arguments set-remove: a set is required");
+    }
+    Hamt set = expect_persistent_set("set-remove", values[0]);
+    for (size_t i = 1; i < values.size(); ++i)
+    {
+        set = set.dissoc(values[i]);
+    }
+    return Expr::make_persistent_set(PersistentSet(std::move(set)));
+}
+
+shared_ptr<Expr> primitives::set_contains(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> set_expr, value_expr = nullptr;
+    primitives_utils::expect_2_args("set-contains?", args, set_expr, value_expr);
+    const auto set_value = eval(context, std::move(set_expr));
+    const auto& set = expect_persistent_set("set-contains?", set_value);
+    return Expr::make_boolean(set.find(eval(context, std::move(value_expr))) != nullptr);
+}
+
+shared_ptr<Expr> primitives::set_count(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> expr = nullptr;
+    primitives_utils::expect_1_arg("set-count", args, expr);
+    const auto set_value = eval(context, std::move(expr));
+    const auto& set = expect_persistent_set("set-count", set_value);
+    return Expr::make_number_int(integer(static_cast<int64_t>(set.size())));
+}
+
+shared_ptr<Expr> primitives::set_to_list(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> expr = nullptr;
+    primitives_utils::expect_1_arg("set->list", args, expr);
+    const auto set_value = eval(context, std::move(expr));
+    shared_ptr<Expr> list = Expr::NIL;
+    for (const auto& [value, _] : expect_persistent_set("set->list", set_value).entries())
+    {
+        list = Expr::make_pair(Pair::cons(value, std::move(list)));
+    }
+    return list;
+}
+
+shared_ptr<Expr> primitives::list_to_set(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> expr = nullptr;
+    primitives_utils::expect_1_arg("list->set", args, expr);
+    const auto list = eval(context, std::move(expr));
+    primitives_utils::expect_list("list->set", list);
+    Hamt set;
+    for (const auto& value : list->as_pair_ref().walk())
+    {
+        set = set.assoc(value, nullptr);
+    }
+    return Expr::make_persistent_set(PersistentSet(std::move(set)));
+}
@@ -0,0 +1,131 @@
+//
+// Created by glom on 11/8/25.
+//
+#include "error.h"
+#include "expr.h"
+#include "list_builder.h"
+#include "context.h"
+#include "pvector.h"
+#include "primitive.h"
+
+const PVector& expect_pvector(const string& proc, const shared_ptr<Expr>& value)
+{
+    if (!value->is_pvector())
+    {
+        throw GlomError("Invalid argument " + proc + ": " + value->to_string() + " is not a pvector");
+    }
+    return value->as_pvector();
+}
+
+shared_ptr<Expr> primitives::pvector(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    return Expr::make_pvector(PVector(primitives_utils::eval_arguments(context, args)));
+}
+
+shared_ptr<Expr> primitives::is_pvector(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> expr = nullptr;
+    primitives_utils::expect_1_arg("pvector?", args, expr);
+    return Expr::make_boolean(eval(context, std::move(expr))->is_pvector());
+}
+
+shared_ptr<Expr> primitives::pvector_length(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> expr = nullptr;
+    primitives_utils::expect_1_arg("pvector-length", args, expr);
+    const auto value = eval(context, std::move(expr));
+    return Expr::make_number_int(integer(static_cast<int64_t>(expect_pvector("pvector-length", value).size())));
+}
+
+shared_ptr<Expr> primitives::pvector_ref(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> vector_expr, index_expr = nullptr;
+    primitives_utils::expect_2_args("pvector-ref", args, vector_expr, index_expr);
+    const auto value = eval(context, std::move(vector_expr));
+    const auto& elements = expect_pvector("pvector-ref", value);
+    return elements.get(primitives_utils::expect_index("pvector-ref", context, std::move(index_expr), elements.size()));
+}
+
+shared_ptr<Expr> primitives::pvector_set(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> vector_expr, index_expr, element_expr = nullptr;
+    primitives_utils::expect_3_args("pvector-set", args, vector_expr, index_expr, element_expr);
+    const auto value = eval(context, std::move(vector_expr));
+    const auto& elements = expect_pvector("pvector-set", value);
+    const auto index = primitives_utils::expect_index("pvector-set", context, std::move(index_expr), elements.size());
+    return Expr::make_pvector(elements.set(index, eval(context, std::move(element_expr))));
+}
+
+shared_ptr<Expr> primitives::pvector_push(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    const auto values = primitives_utils::eval_arguments(context, args);
+    if (values.empty())
+    {
+        throw GlomError("Invalid number of arguments pvector-push: a pvector is required");
+    }
+    PVector result = expect_pvector("pvector-push", values[0]);
+    for (size_t i = 1; i < values.size(); ++i)
+    {
+        result = result.push_back(values[i]);
+    }
+    return Expr::make_pvector(std::move(result));
+}
+
+shared_ptr<Expr> primitives::pvector_append(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    PVector result;
+    for (const auto& value : primitives_utils::eval_arguments(context, args))
+    {
+        result = result.concat(expect_pvector("pvector-append", value));
+    }
+    return Expr::make_pvector(std::move(result));
+}
+
+shared_ptr<Expr> primitives::pvector_slice(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> vector_expr, start_expr, end_expr = nullptr;
+    primitives_utils::expect_2_or_3_args("pvector-slice", args, vector_expr, start_expr, end_expr);
+    const auto value = eval(context, std::move(vector_expr));
+    const auto& elements = expect_pvector("pvector-slice", value);
+    // Both bounds may sit one past the last element
+    const auto start = primitives_utils::expect_index("pvector-slice", context, std::move(start_expr),
+                                                      elements.size() + 1);
+    const auto end = end_expr
+                         ? primitives_utils::expect_index("pvector-slice", context, std::move(end_expr),
+                                                          elements.size() + 1)
+                         : elements.size();
+    if (start > end)
+    {
+        throw GlomError("Invalid argument pvector-slice: start " + std::to_string(start) + " is after end " +
+                        std::to_string(end));
+    }
+    return Expr::make_pvector(elements.slice(start, end));
+}
+
+shared_ptr<Expr> primitives::pvector_to_list(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> expr = nullptr;
+    primitives_utils::expect_1_arg("pvector->list", args, expr);
+    const auto value = eval(context, std::move(expr));
+    const auto elements = expect_pvector("pvector->list", value).elements();
+    ListBuilder list;
+    for (const auto& element : elements)
+    {
+        list.push_back(element);
+    }
+    return list.build();
+}
+
+shared_ptr<Expr> primitives::list_to_pvector(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> expr = nullptr;
+    primitives_utils::expect_1_arg("list->pvector", args, expr);
+    const auto list = eval(context, std::move(expr));
+    primitives_utils::expect_list("list->pvector", list);
+    vector<shared_ptr<Expr>> elements;
+    for (const auto& element : list->as_pair_ref().walk())
+    {
+        elements.push_back(element);
+    }
+    return Expr::make_pvector(PVector(elements));
+}
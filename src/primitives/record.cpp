@@ -0,0 +1,174 @@
+//
+// Created by glom on 11/11/25.
+//
+#include "error.h"
+#include "expr.h"
+#include "context.h"
+#include "record.h"
+#include "primitive.h"
+
+const string_view& expect_symbol(const shared_ptr<Expr>& expr, const string& what)
+{
+    if (!expr->is_symbol())
+    {
+        throw GlomError("Invalid syntax define-record-type: " + what + " must be a symbol: " + expr->to_string());
+    }
+    return expr->as_symbol();
+}
+
+// The symbols of a list such as (constructor field ...) or (field accessor [modifier])
+vector<string_view> expect_symbols(const shared_ptr<Expr>& expr, const string& what)
+{
+    if (!expr->is_pair() || expr->is_nil())
+    {
+        throw GlomError("Invalid syntax define-record-type: " + what + " must be a list: " + expr->to_string());
+    }
+    vector<string_view> symbols;
+    auto cursor = expr->as_pair_ref().walk();
+    for (; !cursor.done(); ++cursor)
+    {
+        symbols.push_back(expect_symbol(*cursor, what));
+    }
+    if (!cursor.tail()->is_nil())
+    {
+        throw GlomError("Invalid syntax define-record-type: " + what + " must be a list: " + expr->to_string());
+    }
+    return symbols;
+}
+
+Record& expect_instance(const string& proc, const RecordType& type, const shared_ptr<Expr>& value)
+{
+    if (!value->is_record() || !value->as_record().is_instance_of(type))
+    {
+        throw GlomError("Invalid argument " + proc + ": " + value->to_string() + " is not a " + type.get_name());
+    }
+    return value->as_record();
+}
+
+void define_constructor(const shared_ptr<Context>& context, const shared_ptr<const RecordType>& type,
+                        const vector<string_view>& spec)
+{
+    auto name = view_to_string(spec[0]);
+    vector<size_t> slots;
+    for (size_t i = 1; i < spec.size(); ++i)
+    {
+        const auto slot = type->slot_of(spec[i]);
+        if (!slot)
+        {
+            throw GlomError("Invalid syntax define-record-type: " + view_to_string(spec[i]) + " is not a field of " +
+                            type->get_name());
+        }
+        slots.push_back(*slot);
+    }
+    context->add_primitive(name, [type, slots = std::move(slots), name](const shared_ptr<Context>& ctx,
+                                                                         shared_ptr<Pair>&& args)
+    {
+        auto values = primitives_utils::eval_arguments(ctx, args);
+        if (values.size() != slots.size())
+        {
+            throw GlomError("Invalid number of arguments " + name + ": exactly " + std::to_string(slots.size()) +
+                            " arguments required");
+        }
+        // Fields the constructor leaves out start unspecified
+        vector<shared_ptr<Expr>> fields(type->get_fields().size(), Expr::NOTHING);
+        for (size_t i = 0; i < slots.size(); ++i)
+        {
+            fields[slots[i]] = std::move(values[i]);
+        }
+        return Expr::make_record(Record(type, std::move(fields)));
+    });
+}
+
+void define_predicate(const shared_ptr<Context>& context, const shared_ptr<const RecordType>& type,
+                      const string_view& symbol)
+{
+    auto name = view_to_string(symbol);
+    context->add_primitive(name, [type, name](const shared_ptr<Context>& ctx, shared_ptr<Pair>&& args)
+    {
+        shared_ptr<Expr> expr = nullptr;
+        primitives_utils::expect_1_arg(name, args, expr);
+        const auto value = eval(ctx, std::move(expr));
+        return Expr::make_boolean(value->is_record() && value->as_record().is_instance_of(*type));
+    });
+}
+
+void define_accessor(const shared_ptr<Context>& context, const shared_ptr<const RecordType>& type,
+                     const string_view& symbol, const size_t slot)
+{
+    auto name = view_to_string(symbol);
+    context->add_primitive(name, [type, name, slot](const shared_ptr<Context>& ctx, shared_ptr<Pair>&& args)
+    {
+        shared_ptr<Expr> expr = nullptr;
+        primitives_utils::expect_1_arg(name, args, expr);
+        const auto value = eval(ctx, std::move(expr));
+        return expect_instance(name, *type, value).get(slot);
+    });
+}
+
+void define_modifier(const shared_ptr<Context>& context, const shared_ptr<const RecordType>& type,
+                     const string_view& symbol, const size_t slot)
+{
+    auto name = view_to_string(symbol);
+    context->add_primitive(name, [type, name, slot](const shared_ptr<Context>& ctx, shared_ptr<Pair>&& args)
+    {
+        shared_ptr<Expr> record_expr, value_expr = nullptr;
+        primitives_utils::expect_2_args(name, args, record_expr, value_expr);
+        const auto value = eval(ctx, std::move(record_expr));
+        auto& record = expect_instance(name, *type, value);
+        record.set(slot, eval(ctx, std::move(value_expr)));
+        return Expr::NOTHING;
+    });
+}
+
+// define-record-type: (define-record-type <name> (constructor field ...) predicate (field accessor [modifier]) ...)
+shared_ptr<Expr> primitives::define_record_type(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    vector<shared_ptr<Expr>> parts;
+    for (const auto& part : *args)
+    {
+        parts.push_back(part);
+    }
+    if (parts.size() < 3)
+    {
+        throw GlomError("Invalid number of arguments define-record-type: at least 3 arguments required");
+    }
+    const auto& type_name = expect_symbol(parts[0], "type name");
+    const auto constructor = expect_symbols(parts[1], "constructor");
+    const auto& predicate = expect_symbol(parts[2], "predicate");
+
+    vector<vector<string_view>> field_specs;
+    vector<string_view> fields;
+    for (size_t i = 3; i < parts.size(); ++i)
+    {
+        auto spec = expect_symbols(parts[i], "field");
+        if (spec.size() < 2 || spec.size() > 3)
+        {
+            throw GlomError("Invalid syntax define-record-type: field must be (field accessor [modifier]): " +
+                            parts[i]->to_string());
+        }
+        for (const auto& field : fields)
+        {
+            if (field.data() == spec[0].data())
+            {
+                throw GlomError("Invalid syntax define-record-type: duplicate field " + view_to_string(field));
+            }
+        }
+        fields.push_back(spec[0]);
+        field_specs.push_back(std::move(spec));
+    }
+
+    const auto type_expr = Expr::make_record_type(RecordType(view_to_string(type_name), std::move(fields)));
+    const auto type = type_expr->as_record_type();
+    context->add(type_name, type_expr);
+    define_constructor(context, type, constructor);
+    define_predicate(context, type, predicate);
+    for (size_t slot = 0; slot < field_specs.size(); ++slot)
+    {
+        define_accessor(context, type, field_specs[slot][1], slot);
+        if (field_specs[slot].size() == 3)
+        {
+            define_modifier(context, type, field_specs[slot][2], slot);
+        }
+    }
+    return Expr::NOTHING;
+}
@@ -0,0 +1,207 @@
+//
+// Created by glom on 11/9/25.
+//
+#include <algorithm>
+
+#include "error.h"
+#include "expr.h"
+#include "list_builder.h"
+#include "context.h"
+#include "primitive.h"
+
+// The cells of a proper list, each an Expr holding one of its pairs
+vector<shared_ptr<Expr>> list_cells(const string& proc, const shared_ptr<Expr>& list)
+{
+    vector<shared_ptr<Expr>> cells;
+    auto current = list;
+    while (!current->is_nil())
+    {
+        if (!current->is_pair())
+        {
+            throw GlomError(proc + ": argument is not a list: " + list->to_string());
+        }
+        cells.push_back(current);
+        current = current->as_pair()->cdr();
+    }
+    return cells;
+}
+
+// A stable natural merge sort of the indices [0, n): ascending runs are kept as they are and
+// strictly descending ones reversed, then neighbouring runs are merged pairwise. less is only
+// ever asked about indices in range, so an inconsistent comparator cannot break the sort.
+template <typename Less>
+vector<size_t> sorted_order(const size_t n, Less less)
+{
+    vector<size_t> order(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        order[i] = i;
+    }
+    vector<size_t> bounds{0};
+    for (size_t start = 0; start < n;)
+    {
+        size_t end = start + 1;
+        if (end < n && less(order[end], order[end - 1]))
+        {
+            while (end < n && less(order[end], order[end - 1]))
+            {
+                ++end;
+            }
+            std::reverse(order.begin() + static_cast<ptrdiff_t>(start), order.begin() + static_cast<ptrdiff_t>(end));
+        }
+        else
+        {
+            while (end < n && !less(order[end], order[end - 1]))
+            {
+                ++end;
+            }
+        }
+        bounds.push_back(end);
+        start = end;
+    }
+    vector<size_t> buffer(n);
+    while (bounds.size() > 2)
+    {
+        vector<size_t> merged{0};
+        for (size_t run = 0; run + 1 < bounds.size(); run += 2)
+        {
+            const size_t lo = bounds[run];
+            const size_t mid = bounds[run + 1];
+            const size_t hi = run + 2 < bounds.size() ? bounds[run + 2] : mid;
+            size_t left = lo, right = mid, out = lo;
+            while (left < mid && right < hi)
+            {
+                // Ties keep the left element first
+                buffer[out++] = less(order[right], order[left]) ? order[right++] : order[left++];
+            }
+            while (left < mid) buffer[out++] = order[left++];
+            while (right < hi) buffer[out++] = order[right++];
+            merged.push_back(hi);
+        }
+        order.swap(buffer);
+        bounds = std::move(merged);
+    }
+    return order;
+}
+
+// The sorted order of the cars of cells, using raw fixnums when less is the builtin < or >
+vector<size_t> sort_cells(const shared_ptr<Context>& context, const vector<shared_ptr<Expr>>& cells,
+                          const shared_ptr<Expr>& less)
+{
+    vector<shared_ptr<Expr>> values;
+    values.reserve(cells.size());
+    bool fixnums = true;
+    for (const auto& cell : cells)
+    {
+        values.push_back(cell->as_pair()->car());
+        fixnums = fixnums && values.back()->is_fixnum();
+    }
+    if (fixnums && less->is_primitive())
+    {
+        const auto& name = less->as_primitive()->get_name();
+        if (name == "<" || name == ">")
+        {
+            vector<int64_t> keys;
+            keys.reserve(values.size());
+            for (const auto& value : values)
+            {
+                keys.push_back(value->as_fixnum());
+            }
+            if (name == "<")
+            {
+                return sorted_order(keys.size(), [&](const size_t a, const size_t b) { return keys[a] < keys[b]; });
+            }
+            return sorted_order(keys.size(), [&](const size_t a, const size_t b) { return keys[a] > keys[b]; });
+        }
+    }
+    vector<shared_ptr<Expr>> call_args(2);
+    return sorted_order(values.size(), [&](const size_t a, const size_t b)
+    {
+        call_args[0] = values[a];
+        call_args[1] = values[b];
+        return apply_procedure(context, less, call_args)->to_boolean();
+    });
+}
+
+shared_ptr<Expr> sort_list(const string& proc, const shared_ptr<Context>& context, const shared_ptr<Expr>& list,
+                           const shared_ptr<Expr>& less)
+{
+    const auto cells = list_cells(proc, list);
+    const auto order = sort_cells(context, cells, less);
+    ListBuilder result;
+    for (const auto index : order)
+    {
+        result.push_back(cells[index]->as_pair()->car());
+    }
+    return result.build();
+}
+
+// sort: (sort list less?)
+shared_ptr<Expr> primitives::sort(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> list, less = nullptr;
+    primitives_utils::expect_2_args("sort", args, list, less);
+    list = eval(context, list);
+    return sort_list("sort", context, list, eval(context, less));
+}
+
+// sort!: relinks the pairs of the list itself in sorted order and returns the new first pair
+shared_ptr<Expr> primitives::sort_in_place(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> list, less = nullptr;
+    primitives_utils::expect_2_args("sort!", args, list, less);
+    list = eval(context, list);
+    less = eval(context, less);
+    const auto cells = list_cells("sort!", list);
+    if (cells.empty())
+    {
+        return Expr::NIL;
+    }
+    const auto order = sort_cells(context, cells, less);
+    for (size_t i = 0; i + 1 < order.size(); ++i)
+    {
+        cells[order[i]]->as_pair()->set_cdr(cells[order[i + 1]]);
+    }
+    cells[order.back()]->as_pair()->set_cdr(Expr::NIL);
+    return cells[order.front()];
+}
+
+// list-sort: (list-sort less? list), the R6RS argument order
+shared_ptr<Expr> primitives::list_sort(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> less, list = nullptr;
+    primitives_utils::expect_2_args("list-sort", args, less, list);
+    less = eval(context, less);
+    return sort_list("list-sort", context, eval(context, list), less);
+}
+
+// merge: (merge list1 list2 less?), taking from list1 on ties
+shared_ptr<Expr> primitives::merge(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> first, second, less = nullptr;
+    primitives_utils::expect_3_args("merge", args, first, second, less);
+    const auto left = list_cells("merge", eval(context, first));
+    const auto right = list_cells("merge", eval(context, second));
+    less = eval(context, less);
+    ListBuilder merged;
+    vector<shared_ptr<Expr>> call_args(2);
+    size_t i = 0, j = 0;
+    while (i < left.size() && j < right.size())
+    {
+        call_args[0] = right[j]->as_pair()->car();
+        call_args[1] = left[i]->as_pair()->car();
+        if (apply_procedure(context, less, call_args)->to_boolean())
+        {
+            merged.push_back(std::move(call_args[0]));
+            ++j;
+        }
+        else
+        {
+            merged.push_back(std::move(call_args[1]));
+            ++i;
+        }
+    }
+    for (; i < left.size(); ++i) merged.push_back(left[i]->as_pair()->car());
+    for (; j < right.size(); ++j) merged.push_back(right[j]->as_pair()->car());
+    return merged.build();
+}
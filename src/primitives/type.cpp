@@ -2,13 +2,15 @@
 // Created by glom on 9/27/25.
 //
 
+#include <cctype>
 #include <cmath>
+#include <limits>
+#include <string_view>
 
 #include "error.h"
 #include "context.h"
 #include "expr.h"
 #include "primitive.h"
-#include "tokenizer.h"
 
 shared_ptr<Expr> primitives::is_pair(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
 {
@@ -115,57 +117,117 @@ shared_ptr<Expr> primitives::inexact_to_exact(const shared_ptr<Context>& context
     return Expr::make_number_exact(rational::from_real(real));
 }
 
+unsigned expect_radix(const string& proc, const shared_ptr<Context>& context, shared_ptr<Expr> expr)
+{
+    const auto radix = eval(context, std::move(expr));
+    if (!radix->is_fixnum() || (radix->as_fixnum() != 2 && radix->as_fixnum() != 8 && radix->as_fixnum() != 10 &&
+                                radix->as_fixnum() != 16))
+    {
+        throw GlomError("Invalid argument " + proc + ": radix " + radix->to_string() + " is not 2, 8, 10 or 16");
+    }
+    return static_cast<unsigned>(radix->as_fixnum());
+}
+
 // number->string
 shared_ptr<Expr> primitives::number_to_string(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
 {
-    shared_ptr<Expr> expr = nullptr;
-    primitives_utils::expect_1_arg("number->string", args, expr);
+    shared_ptr<Expr> expr, radix_expr = nullptr;
+    primitives_utils::expect_1_or_2_args("number->string", args, expr, radix_expr);
     expr = eval(context, std::move(expr));
     if (!expr->is_number())
     {
         throw GlomError("Invalid argument number->string: " + expr->to_string() + " is not a number");
     }
+    const auto radix = radix_expr ? expect_radix("number->string", context, std::move(radix_expr)) : 10;
     if (expr->is_number_int())
     {
-        return Expr::make_string(std::make_unique<string>(expr->as_number_int().to_decimal_string()));
+        return Expr::make_string(std::make_unique<string>(expr->as_number_int().to_string(radix)));
     }
     if (expr->is_number_rat())
     {
-        return Expr::make_string(std::make_unique<string>(expr->as_number_rat().to_rational_string()));
+        return Expr::make_string(std::make_unique<string>(expr->as_number_rat().to_string(radix)));
+    }
+    if (radix != 10)
+    {
+        throw GlomError("Invalid argument number->string: inexact numbers can only be written in radix 10");
     }
-    return Expr::make_string(std::make_unique<string>(std::to_string(expr->as_number_real())));
+    return Expr::make_string(std::make_unique<string>(to_string(expr->as_number_real())));
 }
 
-// string->number
-shared_ptr<Expr> primitives::string_to_number(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+// Reads a number straight from the text, nullptr if it is not one
+shared_ptr<Expr> parse_number(std::string_view text, unsigned radix)
 {
-    shared_ptr<Expr> expr = nullptr;
-    primitives_utils::expect_1_arg("string->number", args, expr);
-    expr = eval(context, std::move(expr));
-    if (!expr->is_string())
+    // Radix prefixes override the radix argument
+    while (text.size() >= 2 && text[0] == '#')
     {
-        throw GlomError("Invalid argument string->number: " + expr->to_string() + " is not a string");
+        switch (std::tolower(static_cast<unsigned char>(text[1])))
+        {
+        case 'b': radix = 2; break;
+        case 'o': radix = 8; break;
+        case 'd': radix = 10; break;
+        case 'x': radix = 16; break;
+        default: return nullptr;
+        }
+        text.remove_prefix(2);
+    }
+    if (const auto slash = text.find('/'); slash != std::string_view::npos)
+    {
+        const auto den_text = text.substr(slash + 1);
+        if (den_text.empty() || den_text.front() == '+' || den_text.front() == '-')
+        {
+            return nullptr;
+        }
+        auto num = integer::parse(text.substr(0, slash), radix);
+        auto den = integer::parse(den_text, radix);
+        if (!num || !den || den->is_zero())
+        {
+            return nullptr;
+        }
+        return Expr::make_number_exact(rational(std::move(*num), std::move(*den)));
+    }
+    if (auto value = integer::parse(text, radix))
+    {
+        return Expr::make_number_int(std::move(*value));
+    }
+    if (radix != 10)
+    {
+        return nullptr;
+    }
+    if (text == "+inf.0" || text == "-inf.0" || text == "+nan.0" || text == "-nan.0")
+    {
+        const real value = text[1] == 'i' ? std::numeric_limits<real>::infinity() : std::numeric_limits<real>::quiet_NaN();
+        return Expr::make_number_real(text[0] == '-' ? -value : value);
     }
-    auto& str = expr->as_string();
-    auto tokenizer = Tokenizer(str);
-    const auto token = tokenizer.next();
-    if (const auto next = tokenizer.next(); next.get_type() != TOKEN_EOI)
+    // Decimal reals: digits with a point and/or an exponent, nothing from_chars would also accept
+    const auto body = text.substr(!text.empty() && (text[0] == '+' || text[0] == '-') ? 1 : 0);
+    if (body.empty() || !(std::isdigit(static_cast<unsigned char>(body[0])) || body[0] == '.') ||
+        body.find_first_not_of("0123456789.eE+-") != std::string_view::npos)
     {
-        return Expr::FALSE;
+        return nullptr;
     }
-    if (token.get_type() == TOKEN_NUMBER_INT)
+    try
     {
-        return Expr::make_number_int(token.as_number_int());
+        return Expr::make_number_real(from_string(std::string(text)));
     }
-    if (token.get_type() == TOKEN_NUMBER_RAT)
+    catch (const std::exception&)
     {
-        return Expr::make_number_rat(token.as_number_rat());
+        return nullptr;
     }
-    if (token.get_type() == TOKEN_NUMBER_REAL)
+}
+
+// string->number
+shared_ptr<Expr> primitives::string_to_number(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> expr, radix_expr = nullptr;
+    primitives_utils::expect_1_or_2_args("string->number", args, expr, radix_expr);
+    expr = eval(context, std::move(expr));
+    if (!expr->is_string())
     {
-        return Expr::make_number_real(token.as_number_real());
+        throw GlomError("Invalid argument string->number: " + expr->to_string() + " is not a string");
     }
-    return Expr::FALSE;
+    const auto radix = radix_expr ? expect_radix("string->number", context, std::move(radix_expr)) : 10;
+    auto number = parse_number(expr->as_string(), radix);
+    return number ? number : Expr::FALSE;
 }
 
 // symbol->string
@@ -208,7 +270,7 @@ shared_ptr<Expr> primitives::eq_string(const shared_ptr<Context>& context, share
     }
     const auto rest = args->cdr()->as_pair();
     const auto& first = first_expr;
-    for (const auto it: *rest)
+    for (const auto& it : *rest)
     {
         if (!it) break;
         const auto next_expr = eval(context, it);
@@ -237,7 +299,7 @@ shared_ptr<Expr> primitives::eq_string_ignore_case(const shared_ptr<Context>& co
     }
     const auto rest = args->cdr()->as_pair();
     const auto& first = first_expr;
-    for (const auto it: *rest)
+    for (const auto& it : *rest)
     {
         if (!it) break;
         const auto next_expr = eval(context, it);
@@ -47,6 +47,27 @@ void primitives_utils::expect_1_arg(const string& proc, const shared_ptr<Pair>&
     a = car;
 }
 
+void primitives_utils::expect_1_or_2_args(const string& proc, const shared_ptr<Pair>& args, shared_ptr<Expr>& a, shared_ptr<Expr>& b)
+{
+    if (args->empty())
+    {
+        throw GlomError(proc + ": expects 1 or 2 arguments, given 0");
+    }
+    a = args->car();
+    const auto cdr = args->cdr();
+    if (cdr->is_nil())
+    {
+        b = nullptr;
+        return;
+    }
+    const auto rest = cdr->as_pair();
+    b = rest->car();
+    if (!rest->cdr()->is_nil())
+    {
+        throw GlomError(proc + ": expects 1 or 2 arguments, given more than 2");
+    }
+}
+
 void primitives_utils::expect_2_args(const string& proc, const shared_ptr<Pair>& args, shared_ptr<Expr>& a, shared_ptr<Expr>& b)
 {
     if (args->empty())
@@ -67,6 +88,15 @@ void primitives_utils::expect_2_args(const string& proc, const shared_ptr<Pair>&
     }
 }
 
+void primitives_utils::expect_3_args(const string& proc, const shared_ptr<Pair>& args, shared_ptr<Expr>& a, shared_ptr<Expr>& b, shared_ptr<Expr>& c)
+{
+    expect_2_or_3_args(proc, args, a, b, c);
+    if (!c)
+    {
+        throw GlomError(proc + ": expects 3 arguments, given 2");
+    }
+}
+
 void primitives_utils::expect_2_or_3_args(const string& proc, const shared_ptr<Pair>& args, shared_ptr<Expr>& a, shared_ptr<Expr>& b, shared_ptr<Expr>& c)
 {
     if (args->empty())
@@ -95,6 +125,49 @@ void primitives_utils::expect_2_or_3_args(const string& proc, const shared_ptr<P
     }
 }
 
+// Checks that list is a proper list: a chain of pairs ending in NIL
+void primitives_utils::expect_list(const string& proc, const shared_ptr<Expr>& list)
+{
+    if (!list->is_pair())
+    {
+        throw GlomError(proc + ": argument is not a list: " + list->to_string());
+    }
+    auto cursor = list->as_pair_ref().walk();
+    while (!cursor.done())
+    {
+        ++cursor;
+    }
+    if (!cursor.tail()->is_nil())
+    {
+        throw GlomError(proc + ": argument is not a list: " + list->to_string());
+    }
+}
+
+// Evaluates every argument, in order
+vector<shared_ptr<Expr>> primitives_utils::eval_arguments(const shared_ptr<Context>& context,
+                                                          const shared_ptr<Pair>& args)
+{
+    vector<shared_ptr<Expr>> values;
+    for (const auto& expr : *args)
+    {
+        if (!expr) break;
+        values.push_back(eval(context, expr));
+    }
+    return values;
+}
+
+// Evaluates an index argument and checks it against [0, size)
+size_t primitives_utils::expect_index(const string& proc, const shared_ptr<Context>& context, shared_ptr<Expr> expr,
+                                      const size_t size)
+{
+    const auto value = eval(context, std::move(expr));
+    if (!value->is_fixnum() || value->as_fixnum() < 0 || static_cast<size_t>(value->as_fixnum()) >= size)
+    {
+        throw GlomError("Invalid argument " + proc + ": index " + value->to_string() + " is out of range");
+    }
+    return static_cast<size_t>(value->as_fixnum());
+}
+
 void primitives_utils::take_car(const string& proc, const shared_ptr<Expr>& list, const shared_ptr<Expr>& expr, shared_ptr<Expr>& car)
 {
     if (!expr->is_pair() || expr->is_nil())
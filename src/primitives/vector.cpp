@@ -0,0 +1,114 @@
+//
+// Created by glom on 11/6/25.
+//
+#include "error.h"
+#include "expr.h"
+#include "context.h"
+#include "primitive.h"
+
+shared_ptr<Vector> expect_vector(const string& proc, const shared_ptr<Context>& context, shared_ptr<Expr> expr)
+{
+    const auto value = eval(context, std::move(expr));
+    if (!value->is_vector())
+    {
+        throw GlomError("Invalid argument " + proc + ": " + value->to_string() + " is not a vector");
+    }
+    return value->as_vector();
+}
+
+shared_ptr<Expr> primitives::vector_of(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    auto elements = std::make_shared<Vector>();
+    for (const auto& expr : *args)
+    {
+        if (!expr) break;
+        elements->push_back(eval(context, expr));
+    }
+    return Expr::make_vector(std::move(elements));
+}
+
+shared_ptr<Expr> primitives::make_vector(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> size_expr, fill_expr = nullptr;
+    primitives_utils::expect_1_or_2_args("make-vector", args, size_expr, fill_expr);
+    size_expr = eval(context, std::move(size_expr));
+    if (!size_expr->is_fixnum() || size_expr->as_fixnum() < 0)
+    {
+        throw GlomError("Invalid argument make-vector: " + size_expr->to_string() + " is not a valid size");
+    }
+    // Every slot shares the one fill value; without one the slots hold 0
+    auto fill = fill_expr ? eval(context, std::move(fill_expr)) : Expr::make_number_int(integer(0));
+    return Expr::make_vector(std::make_shared<Vector>(static_cast<size_t>(size_expr->as_fixnum()), std::move(fill)));
+}
+
+shared_ptr<Expr> primitives::is_vector(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> expr = nullptr;
+    primitives_utils::expect_1_arg("vector?", args, expr);
+    expr = eval(context, std::move(expr));
+    return Expr::make_boolean(expr->is_vector());
+}
+
+shared_ptr<Expr> primitives::vector_length(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> expr = nullptr;
+    primitives_utils::expect_1_arg("vector-length", args, expr);
+    const auto elements = expect_vector("vector-length", context, std::move(expr));
+    return Expr::make_number_int(integer(static_cast<int64_t>(elements->size())));
+}
+
+shared_ptr<Expr> primitives::vector_ref(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> vector_expr, index_expr = nullptr;
+    primitives_utils::expect_2_args("vector-ref", args, vector_expr, index_expr);
+    const auto elements = expect_vector("vector-ref", context, std::move(vector_expr));
+    const auto index = primitives_utils::expect_index("vector-ref", context, std::move(index_expr), elements->size());
+    return (*elements)[index];
+}
+
+shared_ptr<Expr> primitives::vector_set(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> vector_expr, index_expr, value_expr = nullptr;
+    primitives_utils::expect_3_args("vector-set!", args, vector_expr, index_expr, value_expr);
+    const auto elements = expect_vector("vector-set!", context, std::move(vector_expr));
+    const auto index = primitives_utils::expect_index("vector-set!", context, std::move(index_expr), elements->size());
+    (*elements)[index] = eval(context, std::move(value_expr));
+    return Expr::NOTHING;
+}
+
+shared_ptr<Expr> primitives::vector_fill(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> vector_expr, fill_expr = nullptr;
+    primitives_utils::expect_2_args("vector-fill!", args, vector_expr, fill_expr);
+    const auto elements = expect_vector("vector-fill!", context, std::move(vector_expr));
+    const auto fill = eval(context, std::move(fill_expr));
+    std::ranges::fill(*elements, fill);
+    return Expr::NOTHING;
+}
+
+shared_ptr<Expr> primitives::vector_to_list(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> expr = nullptr;
+    primitives_utils::expect_1_arg("vector->list", args, expr);
+    const auto elements = expect_vector("vector->list", context, std::move(expr));
+    shared_ptr<Expr> list = Expr::NIL;
+    for (size_t i = elements->size(); i > 0; --i)
+    {
+        list = Expr::make_pair(Pair::cons((*elements)[i - 1], std::move(list)));
+    }
+    return list;
+}
+
+shared_ptr<Expr> primitives::list_to_vector(const shared_ptr<Context>& context, shared_ptr<Pair>&& args)
+{
+    shared_ptr<Expr> expr = nullptr;
+    primitives_utils::expect_1_arg("list->vector", args, expr);
+    const auto list = eval(context, std::move(expr));
+    primitives_utils::expect_list("list->vector", list);
+    auto elements = std::make_shared<Vector>();
+    for (const auto& element : list->as_pair_ref().walk())
+    {
+        elements->push_back(element);
+    }
+    return Expr::make_vector(std::move(elements));
+}
@@ -0,0 +1,395 @@
+//
+// Created by glom on 11/8/25.
+//
+#include "pvector.h"
+
+#include <algorithm>
+
+namespace
+{
+    constexpr unsigned BITS = 5;
+    constexpr size_t BRANCHING = 1 << BITS;
+    // Nodes a rebalanced seam may hold beyond the minimum, bounding the size table scan
+    constexpr size_t EXTRAS = 2;
+}
+
+struct PVector::Node
+{
+    // A leaf holds elements and an inner node holds children; neither is ever empty
+    std::vector<std::shared_ptr<Expr>> elements;
+    std::vector<NodePtr> children;
+    // Cumulative child sizes, or empty when every child but the last is full
+    std::vector<size_t> sizes;
+    size_t total = 0;
+
+    [[nodiscard]] bool is_leaf() const;
+    [[nodiscard]] size_t slots() const;
+    // The child holding index, which becomes an index into that child
+    [[nodiscard]] size_t locate(size_t& index, unsigned shift) const;
+
+    [[nodiscard]] NodePtr assign(size_t index, std::shared_ptr<Expr> value, unsigned shift) const;
+    // The first n elements, 0 < n <= total
+    static NodePtr take(const NodePtr& node, size_t n, unsigned shift);
+    // All but the first n elements, 0 <= n < total
+    static NodePtr drop(const NodePtr& node, size_t n, unsigned shift);
+    void collect(std::vector<std::shared_ptr<Expr>>& out) const;
+
+    static NodePtr make_leaf(std::vector<std::shared_ptr<Expr>> elements);
+    static NodePtr make_inner(std::vector<NodePtr> children, unsigned shift);
+    // A node at max(left_shift, right_shift) + BITS holding the elements of both
+    static NodePtr merge(const NodePtr& left, unsigned left_shift, const NodePtr& right, unsigned right_shift);
+    static std::vector<NodePtr> rebalance(std::vector<NodePtr> nodes, unsigned shift);
+    static NodePtr wrap(std::vector<NodePtr> nodes, unsigned shift);
+};
+
+bool PVector::Node::is_leaf() const
+{
+    return children.empty();
+}
+
+size_t PVector::Node::slots() const
+{
+    return is_leaf() ? elements.size() : children.size();
+}
+
+size_t PVector::Node::locate(size_t& index, const unsigned shift) const
+{
+    size_t child = index >> shift;
+    if (sizes.empty())
+    {
+        index -= child << shift;
+        return child;
+    }
+    // A relaxed child never holds more than a full one, so the radix guess is a lower bound
+    while (sizes[child] <= index)
+    {
+        ++child;
+    }
+    if (child > 0)
+    {
+        index -= sizes[child - 1];
+    }
+    return child;
+}
+
+PVector::NodePtr PVector::Node::make_leaf(std::vector<std::shared_ptr<Expr>> elements)
+{
+    auto node = std::make_shared<Node>();
+    node->total = elements.size();
+    node->elements = std::move(elements);
+    return node;
+}
+
+PVector::NodePtr PVector::Node::make_inner(std::vector<NodePtr> children, const unsigned shift)
+{
+    auto node = std::make_shared<Node>();
+    bool relaxed = false;
+    for (size_t i = 0; i < children.size(); ++i)
+    {
+        node->total += children[i]->total;
+        relaxed = relaxed || (i + 1 < children.size() && children[i]->total != size_t{1} << shift);
+    }
+    if (relaxed)
+    {
+        size_t sum = 0;
+        node->sizes.reserve(children.size());
+        for (const auto& child : children)
+        {
+            sum += child->total;
+            node->sizes.push_back(sum);
+        }
+    }
+    node->children = std::move(children);
+    return node;
+}
+
+PVector::NodePtr PVector::Node::assign(size_t index, std::shared_ptr<Expr> value, const unsigned shift) const
+{
+    auto copy = std::make_shared<Node>(*this);
+    if (is_leaf())
+    {
+        copy->elements[index] = std::move(value);
+        return copy;
+    }
+    const size_t child = locate(index, shift);
+    copy->children[child] = children[child]->assign(index, std::move(value), shift - BITS);
+    return copy;
+}
+
+PVector::NodePtr PVector::Node::take(const NodePtr& node, const size_t n, const unsigned shift)
+{
+    if (n == node->total)
+    {
+        return node;
+    }
+    if (node->is_leaf())
+    {
+        return make_leaf({node->elements.begin(), node->elements.begin() + static_cast<ptrdiff_t>(n)});
+    }
+    size_t last = n - 1;
+    const size_t child = node->locate(last, shift);
+    std::vector<NodePtr> kept(node->children.begin(), node->children.begin() + static_cast<ptrdiff_t>(child));
+    kept.push_back(take(node->children[child], last + 1, shift - BITS));
+    return make_inner(std::move(kept), shift);
+}
+
+PVector::NodePtr PVector::Node::drop(const NodePtr& node, const size_t n, const unsigned shift)
+{
+    if (n == 0)
+    {
+        return node;
+    }
+    if (node->is_leaf())
+    {
+        return make_leaf({node->elements.begin() + static_cast<ptrdiff_t>(n), node->elements.end()});
+    }
+    size_t first = n;
+    const size_t child = node->locate(first, shift);
+    std::vector<NodePtr> kept{drop(node->children[child], first, shift - BITS)};
+    kept.insert(kept.end(), node->children.begin() + static_cast<ptrdiff_t>(child) + 1, node->children.end());
+    return make_inner(std::move(kept), shift);
+}
+
+void PVector::Node::collect(std::vector<std::shared_ptr<Expr>>& out) const
+{
+    if (is_leaf())
+    {
+        out.insert(out.end(), elements.begin(), elements.end());
+        return;
+    }
+    for (const auto& child : children)
+    {
+        child->collect(out);
+    }
+}
+
+// Repacks sibling nodes at shift so that there are at most EXTRAS more of them than
+// their slots strictly need, copying only the nodes whose contents move
+std::vector<PVector::NodePtr> PVector::Node::rebalance(std::vector<NodePtr> nodes, const unsigned shift)
+{
+    std::vector<size_t> plan;
+    size_t total_slots = 0;
+    for (const auto& node : nodes)
+    {
+        plan.push_back(node->slots());
+        total_slots += node->slots();
+    }
+    const size_t optimal = (total_slots + BRANCHING - 1) / BRANCHING;
+    size_t count = plan.size();
+    if (count <= optimal + EXTRAS)
+    {
+        return nodes;
+    }
+    // Empty the first underfull node into its successors, one node at a time
+    size_t i = 0;
+    while (count > optimal + EXTRAS)
+    {
+        while (plan[i] >= BRANCHING - 1)
+        {
+            ++i;
+        }
+        size_t remaining = plan[i];
+        while (remaining > 0)
+        {
+            const size_t filled = std::min(remaining + plan[i + 1], BRANCHING);
+            remaining = remaining + plan[i + 1] - filled;
+            plan[i] = filled;
+            ++i;
+        }
+        std::copy(plan.begin() + static_cast<ptrdiff_t>(i) + 1, plan.begin() + static_cast<ptrdiff_t>(count),
+                  plan.begin() + static_cast<ptrdiff_t>(i));
+        --count;
+        --i;
+    }
+
+    std::vector<NodePtr> result;
+    result.reserve(count);
+    size_t source = 0;
+    size_t offset = 0;
+    for (size_t target = 0; target < count; ++target)
+    {
+        if (offset == 0 && nodes[source]->slots() == plan[target])
+        {
+            result.push_back(std::move(nodes[source++]));
+            continue;
+        }
+        std::vector<std::shared_ptr<Expr>> elements;
+        std::vector<NodePtr> children;
+        for (size_t filled = 0; filled < plan[target];)
+        {
+            const auto& node = *nodes[source];
+            const size_t step = std::min(plan[target] - filled, node.slots() - offset);
+            const auto begin = static_cast<ptrdiff_t>(offset);
+            const auto end = static_cast<ptrdiff_t>(offset + step);
+            if (node.is_leaf())
+            {
+                elements.insert(elements.end(), node.elements.begin() + begin, node.elements.begin() + end);
+            }
+            else
+            {
+                children.insert(children.end(), node.children.begin() + begin, node.children.begin() + end);
+            }
+            filled += step;
+            offset += step;
+            if (offset == node.slots())
+            {
+                ++source;
+                offset = 0;
+            }
+        }
+        result.push_back(children.empty() ? make_leaf(std::move(elements)) : make_inner(std::move(children), shift));
+    }
+    return result;
+}
+
+// Rebalances the children of a level at shift and stacks them under a node one level up
+PVector::NodePtr PVector::Node::wrap(std::vector<NodePtr> nodes, const unsigned shift)
+{
+    nodes = rebalance(std::move(nodes), shift - BITS);
+    if (nodes.size() <= BRANCHING)
+    {
+        return make_inner({make_inner(std::move(nodes), shift)}, shift + BITS);
+    }
+    std::vector<NodePtr> rest(nodes.begin() + BRANCHING, nodes.end());
+    nodes.resize(BRANCHING);
+    return make_inner({make_inner(std::move(nodes), shift), make_inner(std::move(rest), shift)}, shift + BITS);
+}
+
+PVector::NodePtr PVector::Node::merge(const NodePtr& left, const unsigned left_shift, const NodePtr& right,
+                                      const unsigned right_shift)
+{
+    if (left_shift > right_shift)
+    {
+        const auto middle = merge(left->children.back(), left_shift - BITS, right, right_shift);
+        std::vector<NodePtr> nodes(left->children.begin(), left->children.end() - 1);
+        nodes.insert(nodes.end(), middle->children.begin(), middle->children.end());
+        return wrap(std::move(nodes), left_shift);
+    }
+    if (left_shift < right_shift)
+    {
+        const auto middle = merge(left, left_shift, right->children.front(), right_shift - BITS);
+        std::vector<NodePtr> nodes(middle->children.begin(), middle->children.end());
+        nodes.insert(nodes.end(), right->children.begin() + 1, right->children.end());
+        return wrap(std::move(nodes), right_shift);
+    }
+    if (left_shift == 0)
+    {
+        if (left->total + right->total <= BRANCHING)
+        {
+            auto elements = left->elements;
+            elements.insert(elements.end(), right->elements.begin(), right->elements.end());
+            return make_inner({make_leaf(std::move(elements))}, BITS);
+        }
+        return make_inner({left, right}, BITS);
+    }
+    const auto middle = merge(left->children.back(), left_shift - BITS, right->children.front(), right_shift - BITS);
+    std::vector<NodePtr> nodes(left->children.begin(), left->children.end() - 1);
+    nodes.insert(nodes.end(), middle->children.begin(), middle->children.end());
+    nodes.insert(nodes.end(), right->children.begin() + 1, right->children.end());
+    return wrap(std::move(nodes), left_shift);
+}
+
+PVector::PVector(NodePtr root, unsigned shift) : root(std::move(root)), shift(shift)
+{
+    // Drop the single-child levels left behind by merges and slices
+    while (this->root && !this->root->is_leaf() && this->root->children.size() == 1)
+    {
+        this->root = this->root->children.front();
+        this->shift -= BITS;
+    }
+    count = this->root ? this->root->total : 0;
+}
+
+PVector::PVector(const std::vector<std::shared_ptr<Expr>>& elements)
+{
+    if (elements.empty())
+    {
+        return;
+    }
+    std::vector<NodePtr> level;
+    for (size_t i = 0; i < elements.size(); i += BRANCHING)
+    {
+        const auto end = elements.begin() + static_cast<ptrdiff_t>(std::min(i + BRANCHING, elements.size()));
+        level.push_back(Node::make_leaf({elements.begin() + static_cast<ptrdiff_t>(i), end}));
+    }
+    while (level.size() > 1)
+    {
+        shift += BITS;
+        std::vector<NodePtr> parents;
+        for (size_t i = 0; i < level.size(); i += BRANCHING)
+        {
+            const auto end = level.begin() + static_cast<ptrdiff_t>(std::min(i + BRANCHING, level.size()));
+            parents.push_back(Node::make_inner({level.begin() + static_cast<ptrdiff_t>(i), end}, shift));
+        }
+        level = std::move(parents);
+    }
+    root = std::move(level.front());
+    count = elements.size();
+}
+
+size_t PVector::size() const
+{
+    return count;
+}
+
+bool PVector::empty() const
+{
+    return count == 0;
+}
+
+const std::shared_ptr<Expr>& PVector::get(size_t index) const
+{
+    const Node* node = root.get();
+    for (unsigned level = shift; !node->is_leaf(); level -= BITS)
+    {
+        node = node->children[node->locate(index, level)].get();
+    }
+    return node->elements[index];
+}
+
+PVector PVector::set(const size_t index, std::shared_ptr<Expr> value) const
+{
+    return {root->assign(index, std::move(value), shift), shift};
+}
+
+PVector PVector::push_back(std::shared_ptr<Expr> value) const
+{
+    return concat(PVector({std::move(value)}));
+}
+
+PVector PVector::concat(const PVector& other) const
+{
+    if (other.empty())
+    {
+        return *this;
+    }
+    if (empty())
+    {
+        return other;
+    }
+    return {Node::merge(root, shift, other.root, other.shift), std::max(shift, other.shift) + BITS};
+}
+
+PVector PVector::slice(const size_t start, const size_t end) const
+{
+    if (start >= end)
+    {
+        return {};
+    }
+    if (start == 0 && end == count)
+    {
+        return *this;
+    }
+    return {Node::drop(Node::take(root, end, shift), start, shift), shift};
+}
+
+std::vector<std::shared_ptr<Expr>> PVector::elements() const
+{
+    std::vector<std::shared_ptr<Expr>> result;
+    result.reserve(count);
+    if (root)
+    {
+        root->collect(result);
+    }
+    return result;
+}
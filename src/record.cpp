@@ -0,0 +1,68 @@
+//
+// Created by glom on 11/11/25.
+//
+#include "record.h"
+
+#include "expr.h"
+
+RecordType::RecordType(std::string name, std::vector<std::string_view> fields)
+    : name(std::move(name)), fields(std::move(fields)) {}
+
+const std::string& RecordType::get_name() const
+{
+    return name;
+}
+
+const std::vector<std::string_view>& RecordType::get_fields() const
+{
+    return fields;
+}
+
+std::optional<size_t> RecordType::slot_of(const std::string_view field) const
+{
+    for (size_t i = 0; i < fields.size(); ++i)
+    {
+        // Field names are interned symbols
+        if (fields[i].data() == field.data())
+        {
+            return i;
+        }
+    }
+    return std::nullopt;
+}
+
+Record::Record(std::shared_ptr<const RecordType> type, std::vector<std::shared_ptr<Expr>> slots)
+    : type(std::move(type)), slots(std::move(slots)) {}
+
+const RecordType& Record::get_type() const
+{
+    return *type;
+}
+
+bool Record::is_instance_of(const RecordType& record_type) const
+{
+    return type.get() == &record_type;
+}
+
+const std::shared_ptr<Expr>& Record::get(const size_t slot) const
+{
+    return slots[slot];
+}
+
+void Record::set(const size_t slot, std::shared_ptr<Expr> value)
+{
+    slots[slot] = std::move(value);
+}
+
+std::string Record::to_string() const
+{
+    std::string result = "#<" + type->get_name();
+    const auto& fields = type->get_fields();
+    for (size_t i = 0; i < slots.size(); ++i)
+    {
+        result += " ";
+        result += fields[i];
+        result += ": " + slots[i]->to_string();
+    }
+    return result + ">";
+}
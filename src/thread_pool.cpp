@@ -0,0 +1,150 @@
+//
+// Created by glom on 11/5/25.
+//
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
+#include <string>
+
+struct ThreadPool::Group
+{
+    size_t pending;
+    std::exception_ptr error;
+};
+
+ThreadPool::ThreadPool(const size_t threads)
+{
+    resize(threads);
+}
+
+ThreadPool::~ThreadPool()
+{
+    stop_workers();
+}
+
+ThreadPool& ThreadPool::instance()
+{
+    static ThreadPool pool(
+        []
+        {
+            const char* env = std::getenv("GLOM_THREADS");
+            if (!env)
+            {
+                return size_t{1};
+            }
+            try
+            {
+                return static_cast<size_t>(std::max(1L, std::stol(env)));
+            }
+            catch (const std::exception&)
+            {
+                return size_t{1};
+            }
+        }());
+    return pool;
+}
+
+void ThreadPool::resize(const size_t threads)
+{
+    stop_workers();
+    std::lock_guard lock(mutex);
+    stopping = false;
+    for (size_t i = 1; i < threads; ++i)
+    {
+        workers.emplace_back(&ThreadPool::worker_loop, this);
+    }
+}
+
+size_t ThreadPool::size()
+{
+    std::lock_guard lock(mutex);
+    return workers.size() + 1;
+}
+
+void ThreadPool::stop_workers()
+{
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    changed.notify_all();
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    workers.clear();
+}
+
+// Runs a task with the lock released, recording its completion in the group
+void ThreadPool::run_task(Task& task, std::unique_lock<std::mutex>& lock)
+{
+    lock.unlock();
+    std::exception_ptr error;
+    try
+    {
+        task.work();
+    }
+    catch (...)
+    {
+        error = std::current_exception();
+    }
+    lock.lock();
+    if (error && !task.group->error)
+    {
+        task.group->error = error;
+    }
+    --task.group->pending;
+}
+
+void ThreadPool::worker_loop()
+{
+    std::unique_lock lock(mutex);
+    while (true)
+    {
+        changed.wait(lock, [this] { return stopping || !queue.empty(); });
+        if (stopping)
+        {
+            return;
+        }
+        auto task = std::move(queue.front());
+        queue.pop_front();
+        run_task(task, lock);
+        changed.notify_all();
+    }
+}
+
+void ThreadPool::run_all(std::vector<std::function<void()>>& tasks)
+{
+    if (tasks.empty())
+    {
+        return;
+    }
+    Group group{tasks.size(), nullptr};
+    std::unique_lock lock(mutex);
+    for (size_t i = 1; i < tasks.size(); ++i)
+    {
+        queue.push_back({std::move(tasks[i]), &group});
+    }
+    changed.notify_all();
+
+    Task first{std::move(tasks[0]), &group};
+    run_task(first, lock);
+    while (group.pending > 0)
+    {
+        if (!queue.empty())
+        {
+            auto task = std::move(queue.front());
+            queue.pop_front();
+            run_task(task, lock);
+            changed.notify_all();
+            continue;
+        }
+        changed.wait(lock);
+    }
+    if (group.error)
+    {
+        std::rethrow_exception(group.error);
+    }
+}
@@ -106,6 +106,11 @@ Token Token::make_left_paren()
     return Token(TOKEN_LPAREN);
 }
 
+Token Token::make_vector_left_paren()
+{
+    return Token(TOKEN_VECTOR_LPAREN);
+}
+
 Token Token::make_right_paren()
 {
     return Token(TOKEN_RPAREN);
@@ -292,7 +297,8 @@ Token Tokenizer::next()
         return Token::make_end_of_input();
     }
     const char current = input[index];
-    if (!lang && index == 0 && current == '#')
+    // Only a leading "#lang ..." or "#!..." line is a header; anything else starting with '#' is data
+    if (!lang && index == 0 && (input.starts_with("#lang") || input.starts_with("#!")))
     {
         lang = true;
         while (index < input.size() && input[index] != '\n')
@@ -317,6 +323,11 @@ Token Tokenizer::next()
         index++;
         return Token::make_left_paren();
     }
+    if (current == '#' && index + 1 < input.size() && input[index + 1] == '(')
+    {
+        index += 2;
+        return Token::make_vector_left_paren();
+    }
     if (current == ')')
     {
         index++;
@@ -0,0 +1,102 @@
+//
+// Created by glom on 11/3/25.
+//
+#include <gtest/gtest.h>
+#include <vector>
+#include <memory>
+
+#include "expr.h"
+#include "context.h"
+#include "parser.h"
+#include "eval.h"
+#include "error.h"
+
+class SchemeBitwiseTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        context = make_root_context();
+    }
+
+    void TearDown() override
+    {
+        context.reset();
+    }
+
+    [[nodiscard]] shared_ptr<Expr> eval(const std::string& input) const
+    {
+        const auto exprs = parse(input);
+        return ::eval(context, exprs);
+    }
+
+    void perform(const std::string& input) const
+    {
+        const auto exprs = parse(input);
+        ::eval(context, exprs);
+    }
+
+    static shared_ptr<Expr> parse_and_get_first(const std::string& input)
+    {
+        const auto exprs = parse(input);
+        if (exprs->empty()) return Expr::NOTHING;
+        return exprs->car();
+    }
+
+    std::shared_ptr<Context> context;
+};
+
+
+TEST_F(SchemeBitwiseTest, LogicalOperations)
+{
+    EXPECT_EQ(integer(8), eval("(bitwise-and 12 10)")->as_number_int());
+    EXPECT_EQ(integer(14), eval("(bitwise-or 12 10)")->as_number_int());
+    EXPECT_EQ(integer(6), eval("(bitwise-xor 12 10)")->as_number_int());
+    EXPECT_EQ(integer(-1), eval("(bitwise-and)")->as_number_int());
+    EXPECT_EQ(integer(0), eval("(bitwise-or)")->as_number_int());
+    EXPECT_EQ(integer(4), eval("(bitwise-and -4 7)")->as_number_int());
+    EXPECT_EQ(integer(-13), eval("(bitwise-not 12)")->as_number_int());
+    EXPECT_EQ(integer(11), eval("(bitwise-not -12)")->as_number_int());
+}
+
+TEST_F(SchemeBitwiseTest, BignumOperations)
+{
+    // Bignums behave as infinitely sign-extended two's complement values
+    EXPECT_EQ("1267650600228229401496703205376", eval("(bitwise-and (expt 2 100) (- (expt 2 101) 1))")->to_string());
+    EXPECT_EQ(integer(0), eval("(bitwise-and (expt 2 100) 255)")->as_number_int());
+    EXPECT_EQ("1267650600228229401496703205631", eval("(bitwise-or (expt 2 100) 255)")->to_string());
+    EXPECT_EQ(integer(0), eval("(bitwise-and (- (expt 2 100)) 255)")->as_number_int());
+    EXPECT_EQ(integer(1), eval("(bitwise-and (- 1 (expt 2 100)) 255)")->as_number_int());
+    EXPECT_EQ("-1267650600228229401496703205376", eval("(bitwise-and (- (expt 2 100)) -1)")->to_string());
+    EXPECT_EQ(integer(-1), eval("(bitwise-xor (expt 2 100) (- -1 (expt 2 100)))")->as_number_int());
+    EXPECT_EQ("-1267650600228229401496703205377", eval("(bitwise-not (expt 2 100))")->to_string());
+    EXPECT_EQ(integer(-1), eval("(bitwise-or (- (expt 2 100)) (- (expt 2 100) 1))")->as_number_int());
+}
+
+TEST_F(SchemeBitwiseTest, ArithmeticShift)
+{
+    EXPECT_EQ(integer(40), eval("(arithmetic-shift 5 3)")->as_number_int());
+    EXPECT_EQ(integer(1), eval("(arithmetic-shift 12 -3)")->as_number_int());
+    EXPECT_EQ(integer(-2), eval("(arithmetic-shift -12 -3)")->as_number_int());
+    EXPECT_EQ(integer(-1), eval("(arithmetic-shift -1 -100)")->as_number_int());
+    EXPECT_EQ(integer(0), eval("(arithmetic-shift 1 -100)")->as_number_int());
+    EXPECT_EQ("9223372036854775808", eval("(arithmetic-shift 1 63)")->to_string());
+    EXPECT_EQ("-9223372036854775808", eval("(arithmetic-shift -1 63)")->to_string());
+    EXPECT_EQ(eval("(expt 2 200)")->to_string(), eval("(arithmetic-shift 1 200)")->to_string());
+    EXPECT_EQ(integer(1), eval("(arithmetic-shift (expt 2 200) -200)")->as_number_int());
+    EXPECT_EQ(integer(-2), eval("(arithmetic-shift (- 1 (expt 2 200)) -199)")->as_number_int());
+}
+
+TEST_F(SchemeBitwiseTest, BitCountAndLength)
+{
+    EXPECT_EQ(integer(2), eval("(bit-count 12)")->as_number_int());
+    EXPECT_EQ(integer(2), eval("(bit-count -13)")->as_number_int());
+    EXPECT_EQ(integer(0), eval("(bit-count 0)")->as_number_int());
+    EXPECT_EQ(integer(101), eval("(bit-count (- (expt 2 101) 1))")->as_number_int());
+    EXPECT_EQ(integer(0), eval("(integer-length 0)")->as_number_int());
+    EXPECT_EQ(integer(4), eval("(integer-length 8)")->as_number_int());
+    EXPECT_EQ(integer(3), eval("(integer-length -8)")->as_number_int());
+    EXPECT_EQ(integer(101), eval("(integer-length (expt 2 100))")->as_number_int());
+    EXPECT_EQ(integer(100), eval("(integer-length (- (expt 2 100)))")->as_number_int());
+    EXPECT_THROW(eval("(bit-count 1.5)"), GlomError);
+}
@@ -77,6 +77,26 @@ TEST_F(SchemeEvalControlTest, Apply_TypeErrorWhenFirstNotProc)
     EXPECT_THROW(perform("(apply 123 '(1 2))"), GlomError);
 }
 
+TEST_F(SchemeEvalControlTest, Apply_DoesNotReevaluateArguments)
+{
+    EXPECT_EQ("(a (b c))", eval("(apply list '(a (b c)))")->to_string());
+    EXPECT_EQ("(x . y)", eval("(apply cons (list 'x 'y))")->to_string());
+}
+
+TEST_F(SchemeEvalControlTest, Apply_LeadingArguments)
+{
+    EXPECT_EQ(integer(10), eval("(apply + 1 2 '(3 4))")->as_number_int());
+    EXPECT_EQ("(1 2)", eval("(apply list 1 2 '())")->to_string());
+    EXPECT_THROW(perform("(apply +)"), GlomError);
+    EXPECT_THROW(perform("(apply + 1 2)"), GlomError);
+}
+
+TEST_F(SchemeEvalControlTest, Apply_IsTailCall)
+{
+    perform("(define (count-down n) (if (= n 0) 'done (apply count-down (list (- n 1)))))");
+    EXPECT_EQ("done", eval("(count-down 100000)")->to_string());
+}
+
 // ---------------- call/cc ----------------
 
 TEST_F(SchemeEvalControlTest, CallCC_RequiresProcOfArityOne)
@@ -0,0 +1,163 @@
+//
+// Created by glom on 11/7/25.
+//
+#include <gtest/gtest.h>
+#include <vector>
+#include <memory>
+
+#include "expr.h"
+#include "context.h"
+#include "parser.h"
+#include "eval.h"
+#include "error.h"
+
+class SchemeHashTableTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        context = make_root_context();
+    }
+
+    void TearDown() override
+    {
+        context.reset();
+    }
+
+    [[nodiscard]] shared_ptr<Expr> eval(const std::string& input) const
+    {
+        const auto exprs = parse(input);
+        return ::eval(context, exprs);
+    }
+
+    void perform(const std::string& input) const
+    {
+        const auto exprs = parse(input);
+        ::eval(context, exprs);
+    }
+
+    static shared_ptr<Expr> parse_and_get_first(const std::string& input)
+    {
+        const auto exprs = parse(input);
+        if (exprs->empty()) return Expr::NOTHING;
+        return exprs->car();
+    }
+
+    std::shared_ptr<Context> context;
+};
+
+
+TEST_F(SchemeHashTableTest, BasicOperations)
+{
+    perform("(define t (make-hash-table))");
+    perform("(hash-table-set! t 'a 1)");
+    perform("(hash-table-set! t \"b\" '(2 3))");
+    EXPECT_EQ(integer(1), eval("(hash-table-ref t 'a)")->as_number_int());
+    EXPECT_EQ("(2 3)", eval("(hash-table-ref t \"b\")")->to_string());
+    EXPECT_EQ("none", eval("(hash-table-ref/default t 'c 'none)")->to_string());
+    EXPECT_EQ("missing", eval("(hash-table-ref t 'c (lambda () 'missing))")->to_string());
+    EXPECT_TRUE(eval("(hash-table-exists? t 'a)")->as_boolean());
+    EXPECT_TRUE(eval("(hash-table? t)")->as_boolean());
+    EXPECT_FALSE(eval("(hash-table? '((a . 1)))")->as_boolean());
+    perform("(hash-table-set! t 'a 10)");
+    EXPECT_EQ(integer(2), eval("(hash-table-size t)")->as_number_int());
+    perform("(hash-table-delete! t 'a)");
+    EXPECT_FALSE(eval("(hash-table-contains? t 'a)")->as_boolean());
+    EXPECT_EQ(integer(1), eval("(hash-table-size t)")->as_number_int());
+    EXPECT_THROW(eval("(hash-table-ref t 'a)"), GlomError);
+    EXPECT_THROW(eval("(hash-table-ref '() 'a)"), GlomError);
+}
+
+TEST_F(SchemeHashTableTest, Equivalences)
+{
+    // equal? tables hash by structure
+    perform("(define t (make-hash-table equal?))");
+    perform("(hash-table-set! t (list 1 \"x\" #(2 3)) 'found)");
+    EXPECT_EQ("found", eval("(hash-table-ref/default t (list 1 \"x\" (vector 2 3)) #f)")->to_string());
+    EXPECT_EQ("false", eval("(hash-table-ref/default t (list 1 \"x\" (vector 2 4)) #f)")->to_string());
+    perform("(hash-table-set! t (f64vector 0 1) 'numeric)");
+    EXPECT_EQ("numeric", eval("(hash-table-ref/default t (f64vector -0.0 1) #f)")->to_string());
+
+    // eq? tables key on identity, except for symbols and exact integers
+    perform("(define e (make-hash-table eq?))");
+    perform("(define key (list 1 2))");
+    perform("(hash-table-set! e key 'same)");
+    perform("(hash-table-set! e 'sym 'symbol)");
+    perform("(hash-table-set! e (expt 2 100) 'big)");
+    EXPECT_EQ("same", eval("(hash-table-ref/default e key #f)")->to_string());
+    EXPECT_EQ("false", eval("(hash-table-ref/default e (list 1 2) #f)")->to_string());
+    EXPECT_EQ("symbol", eval("(hash-table-ref/default e 'sym #f)")->to_string());
+    EXPECT_EQ("big", eval("(hash-table-ref/default e (expt 2 100) #f)")->to_string());
+
+    // eqv? tables compare numbers by value and strings by contents
+    perform("(define v (make-hash-table eqv?))");
+    perform("(hash-table-set! v 2 'two)");
+    perform("(hash-table-set! v 1/2 'half)");
+    perform("(hash-table-set! v \"s\" 'string)");
+    EXPECT_EQ("two", eval("(hash-table-ref/default v 2.0 #f)")->to_string());
+    EXPECT_EQ("half", eval("(hash-table-ref/default v 0.5 #f)")->to_string());
+    EXPECT_EQ("string", eval("(hash-table-ref/default v \"s\" #f)")->to_string());
+    EXPECT_EQ("false", eval("(hash-table-ref/default v (list 2) #f)")->to_string());
+
+    EXPECT_THROW(eval("(make-hash-table (lambda (a b) #t))"), GlomError);
+}
+
+TEST_F(SchemeHashTableTest, CyclicKeys)
+{
+    perform("(define t (make-hash-table))");
+    perform("(define cycle (list 1 2))");
+    perform("(set-cdr! (cdr cycle) cycle)");
+    perform("(hash-table-set! t cycle 'cyclic)");
+    EXPECT_EQ("cyclic", eval("(hash-table-ref t cycle)")->to_string());
+}
+
+TEST_F(SchemeHashTableTest, UpdateAndTraversal)
+{
+    perform("(define t (make-hash-table))");
+    perform("(hash-table-update!/default t 'x (lambda (n) (+ n 1)) 0)");
+    perform("(hash-table-update!/default t 'x (lambda (n) (+ n 1)) 0)");
+    perform("(hash-table-update! t 'y (lambda (l) (cons 'b l)) (lambda () '(a)))");
+    EXPECT_EQ(integer(2), eval("(hash-table-ref t 'x)")->as_number_int());
+    EXPECT_EQ("(b a)", eval("(hash-table-ref t 'y)")->to_string());
+    EXPECT_THROW(eval("(hash-table-update! t 'z (lambda (n) n))"), GlomError);
+
+    // Keys and values reach the procedures without being evaluated again
+    perform("(define seen '())");
+    perform("(hash-table-walk t (lambda (k v) (set! seen (cons k seen))))");
+    EXPECT_EQ(integer(2), eval("(length seen)")->as_number_int());
+    EXPECT_EQ(integer(2), eval("(hash-table-fold t (lambda (k v acc) (+ acc 1)) 0)")->as_number_int());
+    EXPECT_EQ(integer(2), eval("(length (hash-table-keys t))")->as_number_int());
+    EXPECT_EQ(integer(2), eval("(length (hash-table-values t))")->as_number_int());
+
+    perform("(define a (alist->hash-table '((k . 1) (j . 2) (k . 3)) eq?))");
+    EXPECT_EQ(integer(1), eval("(hash-table-ref a 'k)")->as_number_int());
+    EXPECT_EQ("((j . 2))", eval("(begin (hash-table-delete! a 'k) (hash-table->alist a))")->to_string());
+    perform("(define c (hash-table-copy a))");
+    perform("(hash-table-clear! a)");
+    EXPECT_EQ(integer(0), eval("(hash-table-size a)")->as_number_int());
+    EXPECT_EQ(integer(1), eval("(hash-table-size c)")->as_number_int());
+
+    // An improper alist is rejected for its tail, not for the tail's type
+    try {
+        (void)eval("(alist->hash-table '((a . 1) . c))");
+        FAIL() << "Expected GlomError";
+    } catch (const GlomError& e) {
+        EXPECT_NE(std::string(e.what()).find("is not a list"), std::string::npos) << e.what();
+    }
+}
+
+TEST_F(SchemeHashTableTest, GrowthAndDeletion)
+{
+    // Interleaved inserts and deletes exercise rehashing and tombstone reuse
+    perform("(define t (make-hash-table))");
+    perform("(define (fill i) (if (< i 5000) (begin (hash-table-set! t i (* i i)) (fill (+ i 1)))))");
+    perform("(define (drop i) (if (< i 5000) (begin (hash-table-delete! t i) (drop (+ i 2)))))");
+    perform("(fill 0)");
+    perform("(drop 0)");
+    EXPECT_EQ(integer(2500), eval("(hash-table-size t)")->as_number_int());
+    EXPECT_FALSE(eval("(hash-table-exists? t 1000)")->as_boolean());
+    EXPECT_EQ(integer(1002001), eval("(hash-table-ref t 1001)")->as_number_int());
+    perform("(fill 0)");
+    EXPECT_EQ(integer(5000), eval("(hash-table-size t)")->as_number_int());
+    EXPECT_EQ(integer(16000000), eval("(hash-table-ref t 4000)")->as_number_int());
+}
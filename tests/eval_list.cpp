@@ -311,4 +311,174 @@ TEST_F(SchemeListTest, AllCadrTest)
     EXPECT_EQ("cddadr", eval("(cddadr list4)")->to_string());
     EXPECT_EQ("cdddar", eval("(cdddar list4)")->to_string());
     EXPECT_EQ("cddddr", eval("(cddddr list4)")->to_string());
-}
\ No newline at end of file
+}
+TEST_F(SchemeListTest, Map)
+{
+    EXPECT_EQ("(2 4 6)", eval("(map (lambda (x) (* x 2)) '(1 2 3))")->to_string());
+    EXPECT_EQ("(5 7)", eval("(map + '(1 2 3) '(4 5))")->to_string());
+    EXPECT_EQ("(1 3)", eval("(map car '((1 2) (3 4)))")->to_string());
+    EXPECT_EQ("((a . 1) (b . 2))", eval("(map cons '(a b) '(1 2))")->to_string());
+    EXPECT_EQ("((1 ()) (2 (3)))", eval("(map (lambda (x . rest) (cons x rest)) '(1 2) '(() (3)))")->to_string());
+    EXPECT_TRUE(eval("(map car '())")->is_nil());
+    EXPECT_THROW(eval("(map (lambda (x y) x) '(1 2))"), std::runtime_error);
+    EXPECT_THROW(eval("(map car 5)"), std::runtime_error);
+    EXPECT_THROW(eval("(map 5 '(1))"), std::runtime_error);
+    EXPECT_THROW(eval("(map car)"), std::runtime_error);
+}
+
+TEST_F(SchemeListTest, ForEach)
+{
+    perform("(define total 0)");
+    perform("(for-each (lambda (x y) (set! total (+ total (* x y)))) '(1 2 3) '(4 5 6))");
+    EXPECT_EQ(integer(32), eval("total")->as_number_int());
+}
+
+TEST_F(SchemeListTest, Filter)
+{
+    EXPECT_EQ("(2 4)", eval("(filter (lambda (x) (= 0 (modulo x 2))) '(1 2 3 4 5))")->to_string());
+    EXPECT_EQ("(1 (2) true)", eval("(filter (lambda (x) x) '(1 #f (2) #t))")->to_string());
+    EXPECT_TRUE(eval("(filter number? '(a b))")->is_nil());
+}
+
+TEST_F(SchemeListTest, Folds)
+{
+    EXPECT_EQ("(((() . 1) . 2) . 3)", eval("(fold-left cons '() '(1 2 3))")->to_string());
+    EXPECT_EQ("(1 2 3)", eval("(fold-right cons '() '(1 2 3))")->to_string());
+    EXPECT_EQ(integer(21), eval("(fold-left + 0 '(1 2 3) '(4 5 6))")->as_number_int());
+    EXPECT_EQ("((1 4) (2 5))", eval("(fold-right (lambda (a b acc) (cons (list a b) acc)) '() '(1 2) '(4 5 6))")->to_string());
+    EXPECT_EQ(integer(10), eval("(reduce + 0 '(1 2 3 4))")->as_number_int());
+    EXPECT_EQ("(4 3 2 . 1)", eval("(reduce cons 0 '(1 2 3 4))")->to_string());
+    EXPECT_EQ(integer(0), eval("(reduce + 0 '())")->as_number_int());
+    EXPECT_THROW(eval("(reduce + 0)"), std::runtime_error);
+}
+
+TEST_F(SchemeListTest, Sort)
+{
+    EXPECT_EQ("(1 2 3 4 5)", eval("(sort '(3 1 4 5 2) <)")->to_string());
+    EXPECT_EQ("(5 4 3 2 1)", eval("(sort '(3 1 4 5 2) >)")->to_string());
+    EXPECT_EQ("(1 1.5 2 3)", eval("(sort '(3 1.5 2 1) <)")->to_string());
+    EXPECT_EQ("(1 2 3)", eval("(list-sort < '(2 3 1))")->to_string());
+    EXPECT_TRUE(eval("(sort '() <)")->is_nil());
+    // Stable: equal keys keep their original order
+    EXPECT_EQ("((1 . a) (1 . c) (2 . b) (2 . d))",
+              eval("(sort '((2 . b) (1 . a) (2 . d) (1 . c)) (lambda (x y) (< (car x) (car y))))")->to_string());
+    EXPECT_EQ("((2 . b) (2 . d) (1 . a) (1 . c))",
+              eval("(list-sort (lambda (x y) (> (car x) (car y))) '((2 . b) (1 . a) (2 . d) (1 . c)))")->to_string());
+    EXPECT_THROW(eval("(sort '(1 . 2) <)"), std::runtime_error);
+    EXPECT_THROW(eval("(sort '(1 a) <)"), std::runtime_error);
+}
+
+TEST_F(SchemeListTest, SortInPlace)
+{
+    perform("(define l (list 5 3 9 1))");
+    perform("(define third (cddr l))");
+    perform("(define sorted (sort! l <))");
+    EXPECT_EQ("(1 3 5 9)", eval("sorted")->to_string());
+    // The original pairs are relinked, not copied
+    EXPECT_EQ("(9)", eval("third")->to_string());
+    EXPECT_EQ("(5 9)", eval("l")->to_string());
+    perform("(define (range a b) (if (>= a b) '() (cons (modulo (* a 7919) 1000) (range (+ a 1) b))))");
+    perform("(define big (range 0 2000))");
+    perform("(define (ordered? l) (or (null? (cdr l)) (and (<= (car l) (cadr l)) (ordered? (cdr l)))))");
+    EXPECT_TRUE(eval("(ordered? (sort big (lambda (a b) (< a b))))")->as_boolean());
+    EXPECT_TRUE(eval("(equal? (sort big <) (sort big (lambda (a b) (< a b))))")->as_boolean());
+    EXPECT_EQ(integer(2000), eval("(length (sort! big <))")->as_number_int());
+}
+
+TEST_F(SchemeListTest, Merge)
+{
+    EXPECT_EQ("(1 2 3 4 5 6)", eval("(merge '(1 3 5) '(2 4 6) <)")->to_string());
+    EXPECT_EQ("((1 . a) (1 . b) (2 . a))",
+              eval("(merge '((1 . a) (2 . a)) '((1 . b)) (lambda (x y) (< (car x) (car y))))")->to_string());
+    EXPECT_EQ("(1 2)", eval("(merge '() '(1 2) <)")->to_string());
+    EXPECT_THROW(eval("(merge '(1) '(2))"), std::runtime_error);
+}
+
+TEST_F(SchemeListTest, BuiltListsAreMutable)
+{
+    perform("(define l (list 1 2 3))");
+    perform("(define a (append l '(4 5)))");
+    perform("(set-cdr! (cdr l) '(9))");
+    perform("(set-car! a 0)");
+    EXPECT_EQ("(1 2 9)", eval("l")->to_string());
+    EXPECT_EQ("(0 2 3 4 5)", eval("a")->to_string());
+    EXPECT_EQ("(1 . 2)", eval("'(1 . 2)")->to_string());
+    // A list outliving the call that built it across many chunks
+    perform("(define (range a b) (if (>= a b) '() (cons a (range (+ a 1) b))))");
+    perform("(define doubled (map (lambda (x) (* 2 x)) (range 0 1000)))");
+    EXPECT_EQ(integer(999000), eval("(fold-left + 0 doubled)")->as_number_int());
+}
+
+TEST_F(SchemeListTest, ImproperLists)
+{
+    EXPECT_EQ("(1 2 . 3)", eval("(cons 1 (cons 2 3))")->to_string());
+    EXPECT_EQ("((1 . 2) (3 . 4))", eval("(list (cons 1 2) (cons 3 4))")->to_string());
+}
+
+TEST_F(SchemeListTest, ListRefAndTail)
+{
+    EXPECT_EQ(integer(3), eval("(list-ref '(1 2 3 4) 2)")->as_number_int());
+    EXPECT_EQ("(3 4)", eval("(list-tail '(1 2 3 4) 2)")->to_string());
+    EXPECT_EQ("()", eval("(list-tail '(1 2) 2)")->to_string());
+    EXPECT_EQ("(1 2)", eval("(list-tail '(1 2) 0)")->to_string());
+    // list-tail shares the pairs of its argument
+    perform("(define l (list 1 2 3))");
+    perform("(set-car! (list-tail l 1) 9)");
+    EXPECT_EQ("(1 9 3)", eval("l")->to_string());
+    EXPECT_THROW(eval("(list-ref '(1 2) 2)"), std::runtime_error);
+    EXPECT_THROW(eval("(list-ref '(1 2) -1)"), std::runtime_error);
+    EXPECT_THROW(eval("(list-tail '(1 2) 3)"), std::runtime_error);
+}
+
+TEST_F(SchemeListTest, Reverse)
+{
+    EXPECT_EQ("(3 2 1)", eval("(reverse '(1 2 3))")->to_string());
+    EXPECT_EQ("()", eval("(reverse '())")->to_string());
+    perform("(define l (list 1 2 3))");
+    perform("(define r (reverse! l))");
+    EXPECT_EQ("(3 2 1)", eval("r")->to_string());
+    // The first pair is now the last one
+    EXPECT_EQ("(1)", eval("l")->to_string());
+    EXPECT_THROW(eval("(reverse '(1 . 2))"), std::runtime_error);
+    EXPECT_THROW(eval("(reverse! 5)"), std::runtime_error);
+}
+
+TEST_F(SchemeListTest, LastPairAndListCopy)
+{
+    EXPECT_EQ("(3)", eval("(last-pair '(1 2 3))")->to_string());
+    EXPECT_EQ("(2 . 3)", eval("(last-pair '(1 2 . 3))")->to_string());
+    EXPECT_THROW(eval("(last-pair '())"), std::runtime_error);
+    perform("(define l (list 1 2 3))");
+    perform("(define c (list-copy l))");
+    perform("(set-car! c 9)");
+    EXPECT_EQ("(1 2 3)", eval("l")->to_string());
+    EXPECT_EQ("(9 2 3)", eval("c")->to_string());
+    EXPECT_EQ("(1 2 . 3)", eval("(list-copy '(1 2 . 3))")->to_string());
+    EXPECT_EQ(integer(5), eval("(list-copy 5)")->as_number_int());
+}
+
+TEST_F(SchemeListTest, Member)
+{
+    EXPECT_EQ("(c d)", eval("(memq 'c '(a b c d))")->to_string());
+    EXPECT_EQ(Expr::FALSE, eval("(memq 'e '(a b c d))"));
+    EXPECT_EQ("(2 3)", eval("(memv 2 '(1 2 3))")->to_string());
+    EXPECT_EQ("((1) 2)", eval("(member '(1) '(0 (1) 2))")->to_string());
+    EXPECT_EQ(Expr::FALSE, eval("(memq '(1) '(0 (1) 2))"));
+    EXPECT_EQ("(4 5)", eval("(member 3 '(1 2 4 5) <)")->to_string());
+    EXPECT_EQ(Expr::FALSE, eval("(memq 'a '())"));
+    EXPECT_THROW(eval("(memq 'a 5)"), std::runtime_error);
+}
+
+TEST_F(SchemeListTest, Assoc)
+{
+    perform("(define config '((host . \"localhost\") (port . 80) ((a b) . list-key)))");
+    EXPECT_EQ("(port . 80)", eval("(assq 'port config)")->to_string());
+    EXPECT_EQ(Expr::FALSE, eval("(assq 'user config)"));
+    EXPECT_EQ("((a b) . list-key)", eval("(assoc '(a b) config)")->to_string());
+    EXPECT_EQ(Expr::FALSE, eval("(assq '(a b) config)"));
+    EXPECT_EQ("(2 . b)", eval("(assv 2 '((1 . a) (2 . b)))")->to_string());
+    EXPECT_EQ("(2.0 . b)", eval("(assoc 2 '((1 . a) (2.0 . b)) =)")->to_string());
+    // Only the first association of a key is found
+    EXPECT_EQ("(a . 1)", eval("(assq 'a '((a . 1) (a . 2)))")->to_string());
+    EXPECT_THROW(eval("(assq 'a '(1 2))"), std::runtime_error);
+}
@@ -9,6 +9,7 @@
 #include "context.h"
 #include "parser.h"
 #include "eval.h"
+#include "error.h"
 
 class SchemeMathTest : public ::testing::Test
 {
@@ -68,6 +69,33 @@ TEST_F(SchemeMathTest, IntegerSquareRoot)
     EXPECT_EQ(integer(10), eval("(isqrt 110)")->as_number_int());
 }
 
+// exact-integer-sqrt / exact-integer-root tests
+TEST_F(SchemeMathTest, ExactIntegerRoots)
+{
+    EXPECT_EQ("(4 1)", eval("(exact-integer-sqrt 17)")->to_string());
+    EXPECT_EQ("(0 0)", eval("(exact-integer-sqrt 0)")->to_string());
+    EXPECT_EQ("(4294967295 8589934590)", eval("(exact-integer-sqrt 18446744073709551615)")->to_string());
+    // 2^200 + 1 and (10^40 + 7)^2 exercise the Newton path
+    EXPECT_EQ("(1267650600228229401496703205376 1)", eval("(exact-integer-sqrt (+ (expt 2 200) 1))")->to_string());
+    EXPECT_EQ("(10000000000000000000000000000000000000007 0)",
+              eval("(exact-integer-sqrt (expt (+ (expt 10 40) 7) 2))")->to_string());
+    EXPECT_EQ("(99999999999999999999999999999999999999999 199999999999999999999999999999999999999998)",
+              eval("(exact-integer-sqrt (- (expt 10 82) 1))")->to_string());
+    EXPECT_EQ(integer(BigInt("10000000000000000000000000000000000000007")),
+              eval("(sqrt (expt (+ (expt 10 40) 7) 2))")->as_number_int());
+    EXPECT_TRUE(eval("(sqrt (+ (expt (+ (expt 10 40) 7) 2) 1))")->is_number_real());
+
+    EXPECT_EQ("(3 0)", eval("(exact-integer-root 27 3)")->to_string());
+    EXPECT_EQ("(-3 -1)", eval("(exact-integer-root -28 3)")->to_string());
+    EXPECT_EQ("(12345678901234567890 0)", eval("(exact-integer-root (expt 12345678901234567890 7) 7)")->to_string());
+    EXPECT_EQ("12345678901234567889", eval("(car (exact-integer-root (- (expt 12345678901234567890 7) 1) 7))")->to_string());
+    EXPECT_EQ("(2 0)", eval("(exact-integer-root (expt 2 1000) 1000)")->to_string());
+    EXPECT_EQ("(1 1)", eval("(exact-integer-root 2 64)")->to_string());
+    EXPECT_THROW(eval("(exact-integer-sqrt -1)"), GlomError);
+    EXPECT_THROW(eval("(exact-integer-root -16 4)"), GlomError);
+    EXPECT_THROW(eval("(exact-integer-root 16 0)"), GlomError);
+}
+
 // log function tests (natural logarithm)
 TEST_F(SchemeMathTest, Logarithm)
 {
@@ -90,4 +90,12 @@ TEST_F(SchemeNumComparatorsTest, GreaterThanOrEqual)
     EXPECT_EQ(Expr::TRUE, eval("(>= 1 1)"));
     EXPECT_EQ(Expr::TRUE, eval("(>= 3 2 1)"));
     EXPECT_EQ(Expr::FALSE, eval("(>= 1 2 1)"));
-}
\ No newline at end of file
+}
+TEST_F(SchemeNumComparatorsTest, MixedFixnumComparison)
+{
+    EXPECT_EQ(Expr::TRUE, eval("(< 9223372036854775807 9223372036854775808)"));
+    EXPECT_EQ(Expr::TRUE, eval("(> -9223372036854775807 -9223372036854775809)"));
+    EXPECT_EQ(Expr::TRUE, eval("(< 1 3/2 2)"));
+    EXPECT_EQ(Expr::TRUE, eval("(= 2 4/2 2.0)"));
+    EXPECT_EQ(Expr::FALSE, eval("(<= 1 2 1.5)"));
+}
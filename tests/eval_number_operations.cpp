@@ -2,6 +2,7 @@
 // Created by glom on 10/1/25.
 //
 #include <gtest/gtest.h>
+#include <cmath>
 #include <vector>
 #include <memory>
 
@@ -9,6 +10,8 @@
 #include "context.h"
 #include "parser.h"
 #include "eval.h"
+#include "error.h"
+#include "thread_pool.h"
 
 class SchemeNumOperationsTest : public ::testing::Test
 {
@@ -133,6 +136,104 @@ TEST_F(SchemeNumOperationsTest, IntegerModulo)
     EXPECT_EQ(integer(-1), eval("(modulo -10 -3)")->as_number_int());
 }
 
+TEST_F(SchemeNumOperationsTest, IntegerExptMod)
+{
+    EXPECT_EQ(integer(445), eval("(exact-integer-expt-mod 4 13 497)")->as_number_int());
+    EXPECT_EQ(integer(1), eval("(exact-integer-expt-mod 7 0 13)")->as_number_int());
+    EXPECT_EQ(integer(0), eval("(exact-integer-expt-mod 7 5 1)")->as_number_int());
+    EXPECT_EQ(integer(4), eval("(exact-integer-expt-mod -2 2 10)")->as_number_int());
+    // Negative bases reduce into [0, modulus) before exponentiating
+    EXPECT_EQ(integer(4), eval("(exact-integer-expt-mod -3 1 7)")->as_number_int());
+    EXPECT_EQ(integer(1), eval("(exact-integer-expt-mod -3 3 7)")->as_number_int());
+    EXPECT_EQ(integer(2), eval("(exact-integer-expt-mod (- (expt 10 29)) 1 7)")->as_number_int());
+    EXPECT_EQ(integer(0), eval("(exact-integer-expt-mod -14 3 7)")->as_number_int());
+    EXPECT_EQ(eval("(- (expt 2 521) 126)")->to_string(),
+              eval("(exact-integer-expt-mod -5 3 (- (expt 2 521) 1))")->to_string());
+    EXPECT_EQ("905774463111932007049781651850171235929",
+              eval("(exact-integer-expt-mod (- (+ (expt 10 40) 7)) 5 (expt 2 130))")->to_string());
+    EXPECT_EQ("13650973289213221238474799801",
+              eval("(exact-integer-expt-mod (- (expt 3 100)) 7 (+ (expt 10 30) 57))")->to_string());
+    // Fermat: a^(p-1) = 1 mod p for the Mersenne prime 2^521 - 1 (odd modulus, Montgomery path)
+    EXPECT_EQ(integer(1), eval("(exact-integer-expt-mod 3 (- (expt 2 521) 2) (- (expt 2 521) 1))")->as_number_int());
+    // Even modulus agrees with the naive computation
+    EXPECT_EQ(eval("(modulo (expt 12345678901234567891 77) (expt 2 130))")->to_string(),
+              eval("(exact-integer-expt-mod 12345678901234567891 77 (expt 2 130))")->to_string());
+    EXPECT_EQ(eval("(modulo (expt 98765432109876543210 123) (+ (expt 10 40) 9))")->to_string(),
+              eval("(exact-integer-expt-mod 98765432109876543210 123 (+ (expt 10 40) 9))")->to_string());
+    EXPECT_THROW(eval("(exact-integer-expt-mod 2 -1 7)"), GlomError);
+    EXPECT_THROW(eval("(exact-integer-expt-mod 2 3 0)"), GlomError);
+}
+
+TEST_F(SchemeNumOperationsTest, ProductTrees)
+{
+    EXPECT_EQ(integer(1), eval("(factorial 0)")->as_number_int());
+    EXPECT_EQ(integer(2432902008176640000), eval("(factorial 20)")->as_number_int());
+    EXPECT_EQ("30414093201713378043612608166064768844377641568960512000000000000", eval("(factorial 50)")->to_string());
+    // Prime-swing factorial agrees with the naive recursion
+    perform("(define (naive-factorial n) (if (= n 0) 1 (* n (naive-factorial (- n 1)))))");
+    EXPECT_EQ(eval("(naive-factorial 300)")->to_string(), eval("(factorial 300)")->to_string());
+
+    EXPECT_EQ(integer(10), eval("(binomial 5 2)")->as_number_int());
+    EXPECT_EQ(integer(0), eval("(binomial 5 6)")->as_number_int());
+    EXPECT_EQ(integer(1), eval("(binomial 7 0)")->as_number_int());
+    EXPECT_EQ("100891344545564193334812497256", eval("(binomial 100 50)")->to_string());
+    EXPECT_EQ(eval("(quotient (factorial 300) (* (factorial 120) (factorial 180)))")->to_string(),
+              eval("(binomial 300 120)")->to_string());
+    EXPECT_EQ(integer(499999500000), eval("(binomial 1000000 2)")->as_number_int());
+
+    EXPECT_EQ(integer(1), eval("(product '())")->as_number_int());
+    EXPECT_EQ(integer(-120), eval("(product '(1 -2 3 4 5))")->as_number_int());
+    EXPECT_EQ(eval("(* 12345678901234567890 98765432109876543210 -3 (expt 2 100))")->to_string(),
+              eval("(product (list 12345678901234567890 98765432109876543210 -3 (expt 2 100)))")->to_string());
+    EXPECT_EQ(rational(integer(3), integer(2)), eval("(product '(1/2 3))")->as_number_rat());
+    EXPECT_DOUBLE_EQ(3.0, eval("(product '(1.5 2))")->as_number_real());
+    EXPECT_THROW(eval("(factorial -1)"), GlomError);
+    EXPECT_THROW(eval("(binomial 5 1/2)"), GlomError);
+    EXPECT_THROW(eval("(product '(1 a))"), GlomError);
+    EXPECT_THROW(eval("(product '(2 3 . 4))"), GlomError);
+    EXPECT_THROW(eval("(product '(1/2 3 . 4))"), GlomError);
+}
+
+TEST_F(SchemeNumOperationsTest, KaratsubaMultiplication)
+{
+    // Reference product from 31-limb slices of b: every partial product stays on the schoolbook loop
+    perform("(define mask (- (expt 2 1984) 1))");
+    perform("(define (sliced-mul a b) (if (= b 0) 0 (+ (* a (bitwise-and b mask))"
+            " (arithmetic-shift (sliced-mul a (arithmetic-shift b -1984)) 1984))))");
+    // 40, 63, 70 and 203 limbs, with all-ones operands to push carries through every split
+    perform("(define ones40 (- (expt 2 2560) 1))");
+    perform("(define ones70 (- (expt 2 4480) 1))");
+    perform("(define ones200 (- (expt 2 12800) 1))");
+    perform("(define pow40 (expt 3 1600))");
+    perform("(define pow63 (+ (expt 7 1430) 1))");
+    perform("(define pow203 (expt 3 8190))");
+    for (const auto& [a, b] : std::vector<std::pair<std::string, std::string>>{
+             {"ones200", "ones40"}, {"pow203", "pow40"}, {"pow203", "ones40"}, {"ones70", "pow40"},
+             {"ones70", "pow63"}, {"pow63", "ones40"}, {"ones200", "pow63"}, {"ones40", "ones40"}})
+    {
+        const auto product = "(* " + a + " " + b + ")";
+        EXPECT_EQ(eval("(sliced-mul " + a + " " + b + ")")->to_string(), eval(product)->to_string())
+            << a << " * " << b;
+        EXPECT_EQ(eval(a)->to_string(), eval("(quotient " + product + " " + b + ")")->to_string()) << a << " * " << b;
+    }
+    // (2^m - 1)(2^n - 1) = 2^(m + n) - 2^m - 2^n + 1
+    EXPECT_EQ(eval("(+ (- (expt 2 15360) (expt 2 2560) (expt 2 12800)) 1)")->to_string(),
+              eval("(* ones200 ones40)")->to_string());
+}
+
+TEST_F(SchemeNumOperationsTest, ParallelMultiplication)
+{
+    // Operands just above 2048 limbs cross the parallel Karatsuba threshold
+    perform("(define a (- (expt 3 83000) 1))");
+    perform("(define b (+ (expt 7 47000) 12345))");
+    perform("(define serial (* a b))");
+    const size_t threads = ThreadPool::instance().size();
+    ThreadPool::instance().resize(4);
+    EXPECT_TRUE(eval("(= serial (* a b))")->as_boolean());
+    EXPECT_TRUE(eval("(= (quotient (* a b) b) a)")->as_boolean());
+    ThreadPool::instance().resize(threads);
+}
+
 // Rational number operations tests
 TEST_F(SchemeNumOperationsTest, RationalAddition)
 {
@@ -181,6 +282,20 @@ TEST_F(SchemeNumOperationsTest, RationalExponentiation)
     EXPECT_EQ(integer(1), eval("(expt 3/4 0)")->as_number_int());
 }
 
+TEST_F(SchemeNumOperationsTest, RationalChains)
+{
+    // Chains are reduced once at the end, the result must still be canonical
+    EXPECT_EQ(integer(1), eval("(+ 1/3 1/3 1/3)")->as_number_int());
+    EXPECT_EQ(rational(integer(61), integer(100)), eval("(+ 1/100 25/100 35/100)")->as_number_rat());
+    EXPECT_EQ(rational(integer(-1), integer(4)), eval("(- 1/4 1/4 1/4)")->as_number_rat());
+    EXPECT_EQ(rational(integer(1), integer(5)), eval("(* 2/3 3/4 2/5)")->as_number_rat());
+    EXPECT_EQ(rational(integer(7), integer(4)), eval("(+ 1/4 1 1/2)")->as_number_rat());
+    EXPECT_DOUBLE_EQ(2.25, eval("(+ 1/4 1 0.5 1/2)")->as_number_real());
+    EXPECT_EQ("1/3", eval("(* (/ 1 (expt 3 80)) (expt 3 79))")->to_string());
+    perform("(define (harmonic n acc) (if (= n 0) acc (harmonic (- n 1) (+ acc (/ 1 n)))))");
+    EXPECT_EQ("7381/2520", eval("(harmonic 10 0)")->to_string());
+}
+
 // Real number operations tests
 TEST_F(SchemeNumOperationsTest, RealAddition)
 {
@@ -316,6 +431,44 @@ TEST_F(SchemeNumOperationsTest, TypeConversion)
     EXPECT_EQ(rational(integer(1), integer(2)), eval("(/ 2 4)")->as_number_rat());
 }
 
+// Fixnum fast path and promotion tests
+TEST_F(SchemeNumOperationsTest, FixnumOverflow)
+{
+    // Fixnum fast paths must promote to bignums exactly at the int64 boundary
+    EXPECT_EQ("9223372036854775807", eval("(+ 9223372036854775806 1)")->to_string());
+    EXPECT_EQ("9223372036854775808", eval("(+ 9223372036854775807 1)")->to_string());
+    EXPECT_EQ("-9223372036854775809", eval("(- -9223372036854775807 1 1)")->to_string());
+    EXPECT_EQ("85070591730234615847396907784232501249", eval("(* 9223372036854775807 9223372036854775807)")->to_string());
+    EXPECT_EQ("9223372036854775808", eval("(* -1 (- -9223372036854775807 1))")->to_string());
+    EXPECT_EQ("18446744073709551614", eval("(+ 9223372036854775807 9223372036854775807 1 -1)")->to_string());
+    EXPECT_EQ("5/2", eval("(+ 1 1 1/2)")->to_string());
+    EXPECT_DOUBLE_EQ(3.5, eval("(+ 1 2 0.5)")->as_number_real());
+}
+
+TEST_F(SchemeNumOperationsTest, AccumulatorPromotion)
+{
+    // The accumulator climbs fixnum -> integer -> rational -> real as operands demand
+    EXPECT_EQ("18446744073709551616", eval("(+ 9223372036854775807 9223372036854775807 2)")->to_string());
+    EXPECT_EQ("36893488147419103233/2", eval("(+ 9223372036854775807 9223372036854775807 5/2)")->to_string());
+    EXPECT_EQ(integer(12), eval("(* 2 3/2 4)")->as_number_int());
+    EXPECT_DOUBLE_EQ(4.0, eval("(+ 1 1/2 2.5)")->as_number_real());
+    EXPECT_EQ(integer(-5), eval("(- 5)")->as_number_int());
+    EXPECT_EQ("-1/2", eval("(- 1/2)")->to_string());
+    EXPECT_EQ("9223372036854775808", eval("(- (- -9223372036854775807 1))")->to_string());
+    perform("(define (iota n acc) (if (= n 0) acc (iota (- n 1) (cons n acc))))");
+    EXPECT_EQ(integer(500500), eval("(apply + (iota 1000 '()))")->as_number_int());
+}
+
+TEST_F(SchemeNumOperationsTest, SmallIntegerCache)
+{
+    // Small integers are shared instances, larger ones are still fresh values
+    EXPECT_EQ(eval("1"), eval("(- 2 1)"));
+    EXPECT_EQ(eval("-1024"), eval("(* -1 1024)"));
+    EXPECT_NE(eval("1025"), eval("(+ 1024 1)"));
+    EXPECT_EQ(integer(1025), eval("(+ 1024 1)")->as_number_int());
+    EXPECT_EQ(Expr::NIL, eval("(cdr (list 1))"));
+}
+
 // Arbitrary precision integer tests
 TEST_F(SchemeNumOperationsTest, ArbitraryPrecisionIntegers)
 {
@@ -112,6 +112,8 @@ TEST_F(SchemeNumUtilsTest, Max)
     EXPECT_EQ(integer(-1), eval("(max -1 -2 -3)")->as_number_int());
     EXPECT_EQ(integer(10), eval("(max 10)")->as_number_int());
     EXPECT_EQ(integer(3), eval("(max 3 3)")->as_number_int());
+    EXPECT_EQ(3.0, eval("(max 1 3 2.0)")->as_number_real());
+    EXPECT_EQ("7/2", eval("(max 1 7/2 3)")->to_string());
 }
 
 // min function tests
@@ -124,6 +126,8 @@ TEST_F(SchemeNumUtilsTest, Min)
     EXPECT_EQ(integer(-3), eval("(min -1 -2 -3)")->as_number_int());
     EXPECT_EQ(integer(10), eval("(min 10)")->as_number_int());
     EXPECT_EQ(integer(3), eval("(min 3 3)")->as_number_int());
+    EXPECT_EQ(1.0, eval("(min 1 3 2.0)")->as_number_real());
+    EXPECT_EQ("-1/2", eval("(min 1 -1/2 9223372036854775808)")->to_string());
 }
 
 // abs function tests
@@ -150,6 +154,21 @@ TEST_F(SchemeNumUtilsTest, Gcd)
     EXPECT_EQ(integer(2), eval("(gcd 2)")->as_number_int());
 }
 
+// gcd on multi-limb integers (Lehmer) and mixed word/bignum operands
+TEST_F(SchemeNumUtilsTest, GcdBignum)
+{
+    EXPECT_TRUE(eval("(expt 2 150)")->as_number_int() ==
+        eval("(gcd (* (expt 2 200) (expt 3 50)) (* (expt 2 150) (expt 5 40)))")->as_number_int());
+    EXPECT_TRUE(eval("(expt 7 60)")->as_number_int() ==
+        eval("(gcd (* (expt 7 60) (+ (expt 2 127) 1)) (* (expt 7 61) (expt 2 90)))")->as_number_int());
+    // Consecutive Fibonacci numbers are the worst case for Euclid and are always coprime
+    perform("(define (fib n a b) (if (= n 0) a (fib (- n 1) b (+ a b))))");
+    EXPECT_EQ(integer(1), eval("(gcd (fib 400 0 1) (fib 401 0 1))")->as_number_int());
+    EXPECT_EQ(integer(6), eval("(gcd (* 6 (expt 10 40)) 42)")->as_number_int());
+    EXPECT_EQ(integer(6), eval("(gcd 42 (* 6 (expt 10 40)))")->as_number_int());
+    EXPECT_EQ(integer(4611686018427387904), eval("(gcd -9223372036854775808 4611686018427387904)")->as_number_int());
+}
+
 // lcm function tests
 TEST_F(SchemeNumUtilsTest, Lcm)
 {
@@ -0,0 +1,131 @@
+//
+// Created by glom on 11/6/25.
+//
+#include <gtest/gtest.h>
+#include <vector>
+#include <memory>
+
+#include "expr.h"
+#include "context.h"
+#include "parser.h"
+#include "eval.h"
+#include "error.h"
+
+class SchemeNumVectorTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        context = make_root_context();
+    }
+
+    void TearDown() override
+    {
+        context.reset();
+    }
+
+    [[nodiscard]] shared_ptr<Expr> eval(const std::string& input) const
+    {
+        const auto exprs = parse(input);
+        return ::eval(context, exprs);
+    }
+
+    void perform(const std::string& input) const
+    {
+        const auto exprs = parse(input);
+        ::eval(context, exprs);
+    }
+
+    static shared_ptr<Expr> parse_and_get_first(const std::string& input)
+    {
+        const auto exprs = parse(input);
+        if (exprs->empty()) return Expr::NOTHING;
+        return exprs->car();
+    }
+
+    std::shared_ptr<Context> context;
+};
+
+
+TEST_F(SchemeNumVectorTest, Construction)
+{
+    EXPECT_EQ("#f64(0.0 0.0 0.0)", eval("(make-f64vector 3)")->to_string());
+    EXPECT_EQ("#s64(7 7)", eval("(make-s64vector 2 7)")->to_string());
+    EXPECT_EQ("#u8(1 2 255)", eval("(u8vector 1 2 255)")->to_string());
+    EXPECT_EQ("#f64(1.5 -2.0)", eval("(f64vector 1.5 -2)")->to_string());
+    EXPECT_EQ("#f64()", eval("(f64vector)")->to_string());
+    EXPECT_EQ(integer(3), eval("(s64vector-length (s64vector 1 2 3))")->as_number_int());
+    EXPECT_TRUE(eval("(f64vector? (f64vector 1))")->as_boolean());
+    EXPECT_FALSE(eval("(f64vector? (s64vector 1))")->as_boolean());
+    EXPECT_FALSE(eval("(u8vector? '(1 2))")->as_boolean());
+}
+
+TEST_F(SchemeNumVectorTest, AccessAndConversion)
+{
+    perform("(define v (make-s64vector 4 0))");
+    perform("(s64vector-set! v 2 (- (expt 2 62)))");
+    EXPECT_EQ("-4611686018427387904", eval("(s64vector-ref v 2)")->to_string());
+    EXPECT_EQ("(0 0 -4611686018427387904 0)", eval("(s64vector->list v)")->to_string());
+    EXPECT_EQ("#u8(3 4 5)", eval("(list->u8vector '(3 4 5))")->to_string());
+    EXPECT_EQ("(3.0 4.5)", eval("(f64vector->list (list->f64vector '(3 9/2)))")->to_string());
+    EXPECT_TRUE(eval("(equal? (u8vector 1 2) (list->u8vector '(1 2)))")->as_boolean());
+    EXPECT_FALSE(eval("(equal? (u8vector 1 2) (s64vector 1 2))")->as_boolean());
+    EXPECT_FALSE(eval("(equal? (f64vector 1 2) (f64vector 1 2 3))")->as_boolean());
+}
+
+TEST_F(SchemeNumVectorTest, InvalidElements)
+{
+    EXPECT_THROW(eval("(u8vector 256)"), GlomError);
+    EXPECT_THROW(eval("(u8vector -1)"), GlomError);
+    EXPECT_THROW(eval("(s64vector (expt 2 63))"), GlomError);
+    EXPECT_THROW(eval("(s64vector 1.5)"), GlomError);
+    EXPECT_THROW(eval("(f64vector 'a)"), GlomError);
+    EXPECT_THROW(eval("(f64vector-ref (f64vector 1 2) 2)"), GlomError);
+    EXPECT_THROW(eval("(f64vector-ref (s64vector 1 2) 0)"), GlomError);
+    EXPECT_THROW(eval("(make-u8vector -1)"), GlomError);
+    EXPECT_THROW(eval("(list->f64vector '(1.5 2.5 . 3.5))"), GlomError);
+    EXPECT_THROW(eval("(list->u8vector '(1 . 2))"), GlomError);
+}
+
+TEST_F(SchemeNumVectorTest, DoubleRounding)
+{
+    // Elements are stored as doubles but print and read back in their shortest decimal form
+    EXPECT_EQ("#f64(0.1 0.2 1.5)", eval("(f64vector 0.1 0.2 1.5)")->to_string());
+    EXPECT_TRUE(eval("(= (f64vector-ref (f64vector 0.1) 0) 0.1)")->as_boolean());
+    EXPECT_TRUE(eval("(equal? (f64vector->list (list->f64vector (list 0.1))) (list 0.1))")->as_boolean());
+    EXPECT_EQ("(0.1 0.7)", eval("(f64vector->list (f64vector 0.1 0.7))")->to_string());
+    // Arithmetic happens in double, so the sum is the double one
+    EXPECT_EQ("0.30000000000000004", eval("(f64vector-sum (f64vector 0.1 0.2))")->to_string());
+    EXPECT_EQ("0.1", eval("(f64vector-min (f64vector 0.3 0.2 0.1 0.4 0.5))")->to_string());
+}
+
+TEST_F(SchemeNumVectorTest, BulkKernels)
+{
+    // 11 elements exercise both the vector loop and the scalar tail
+    perform("(define a (f64vector 1 2 3 4 5 6 7 8 9 10 11))");
+    perform("(define b (make-f64vector 11 2))");
+    EXPECT_DOUBLE_EQ(66.0, static_cast<double>(eval("(f64vector-sum a)")->as_number_real()));
+    EXPECT_DOUBLE_EQ(132.0, static_cast<double>(eval("(f64vector-dot a b)")->as_number_real()));
+    EXPECT_EQ("#f64(3.0 4.0 5.0 6.0 7.0 8.0 9.0 10.0 11.0 12.0 13.0)", eval("(f64vector-add a b)")->to_string());
+    EXPECT_EQ("#f64(2.0 4.0 6.0 8.0 10.0 12.0 14.0 16.0 18.0 20.0 22.0)", eval("(f64vector-mul a b)")->to_string());
+    EXPECT_EQ("#f64(0.5 1.0 1.5 2.0 2.5 3.0 3.5 4.0 4.5 5.0 5.5)", eval("(f64vector-scale a 1/2)")->to_string());
+    EXPECT_DOUBLE_EQ(1.0, static_cast<double>(eval("(f64vector-min a)")->as_number_real()));
+    EXPECT_DOUBLE_EQ(11.0, static_cast<double>(eval("(f64vector-max a)")->as_number_real()));
+    EXPECT_DOUBLE_EQ(-7.0, static_cast<double>(eval("(f64vector-min (f64vector 3 1 4 1 5 9 2 6 -7))")->as_number_real()));
+    EXPECT_DOUBLE_EQ(0.0, static_cast<double>(eval("(f64vector-sum (f64vector))")->as_number_real()));
+    EXPECT_THROW(eval("(f64vector-add a (f64vector 1 2))"), GlomError);
+    EXPECT_THROW(eval("(f64vector-max (f64vector))"), GlomError);
+    EXPECT_THROW(eval("(f64vector-sum (s64vector 1 2))"), GlomError);
+}
+
+TEST_F(SchemeNumVectorTest, ExtremumNaN)
+{
+    // A NaN anywhere, in the vector loop or the scalar tail, makes min and max NaN
+    perform("(define nan (/ 0.0 0.0))");
+    for (const auto& vector : {"(f64vector nan 1 2 3 4)", "(f64vector 1 nan 2 3 4)", "(f64vector 1 2 3 4 nan)",
+                               "(f64vector 1 2 3 4 5 6 7 nan 9)", "(f64vector nan)", "(f64vector 1 nan)"})
+    {
+        EXPECT_EQ("+nan.0", eval(std::string("(f64vector-min ") + vector + ")")->to_string()) << vector;
+        EXPECT_EQ("+nan.0", eval(std::string("(f64vector-max ") + vector + ")")->to_string()) << vector;
+    }
+}
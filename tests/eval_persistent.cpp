@@ -0,0 +1,127 @@
+//
+// Created by glom on 11/7/25.
+//
+#include <gtest/gtest.h>
+#include <vector>
+#include <memory>
+
+#include "expr.h"
+#include "context.h"
+#include "parser.h"
+#include "eval.h"
+#include "error.h"
+
+class SchemePersistentTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        context = make_root_context();
+    }
+
+    void TearDown() override
+    {
+        context.reset();
+    }
+
+    [[nodiscard]] shared_ptr<Expr> eval(const std::string& input) const
+    {
+        const auto exprs = parse(input);
+        return ::eval(context, exprs);
+    }
+
+    void perform(const std::string& input) const
+    {
+        const auto exprs = parse(input);
+        ::eval(context, exprs);
+    }
+
+    static shared_ptr<Expr> parse_and_get_first(const std::string& input)
+    {
+        const auto exprs = parse(input);
+        if (exprs->empty()) return Expr::NOTHING;
+        return exprs->car();
+    }
+
+    std::shared_ptr<Context> context;
+};
+
+
+TEST_F(SchemePersistentTest, MapOperations)
+{
+    perform("(define m (persistent-map 'a 1 \"b\" '(2 3)))");
+    EXPECT_EQ(integer(1), eval("(map-ref m 'a)")->as_number_int());
+    EXPECT_EQ("(2 3)", eval("(map-ref m \"b\")")->to_string());
+    EXPECT_EQ("none", eval("(map-ref m 'c 'none)")->to_string());
+    EXPECT_TRUE(eval("(map-contains? m 'a)")->as_boolean());
+    EXPECT_TRUE(eval("(map? m)")->as_boolean());
+    EXPECT_FALSE(eval("(map? '((a . 1)))")->as_boolean());
+    EXPECT_EQ(integer(2), eval("(map-count m)")->as_number_int());
+    EXPECT_EQ(integer(10), eval("(map-ref (map-assoc m 'a 10) 'a)")->as_number_int());
+    EXPECT_EQ(integer(3), eval("(map-count (map-assoc m 'a 10 'c 3))")->as_number_int());
+    EXPECT_FALSE(eval("(map-contains? (map-dissoc m 'a) 'a)")->as_boolean());
+    EXPECT_EQ(integer(2), eval("(map-count (map-dissoc m 'missing))")->as_number_int());
+    EXPECT_EQ("((a . 1))", eval("(map->alist (map-dissoc m \"b\"))")->to_string());
+    EXPECT_EQ(integer(1), eval("(map-ref (alist->map '((x . 1) (x . 2))) 'x)")->as_number_int());
+    EXPECT_THROW(eval("(map-ref m 'c)"), GlomError);
+    EXPECT_THROW(eval("(map-assoc m 'a)"), GlomError);
+    EXPECT_THROW(eval("(map-ref '() 'a)"), GlomError);
+    try {
+        (void)eval("(alist->map '((a . 1) . c))");
+        FAIL() << "Expected GlomError";
+    } catch (const GlomError& e) {
+        EXPECT_NE(std::string(e.what()).find("is not a list"), std::string::npos) << e.what();
+    }
+}
+
+TEST_F(SchemePersistentTest, Snapshots)
+{
+    perform("(define m1 (persistent-map 'a 1))");
+    perform("(define m2 (map-assoc m1 'b 2))");
+    perform("(define m3 (map-dissoc m2 'a))");
+    EXPECT_EQ(integer(1), eval("(map-count m1)")->as_number_int());
+    EXPECT_FALSE(eval("(map-contains? m1 'b)")->as_boolean());
+    EXPECT_EQ(integer(2), eval("(map-count m2)")->as_number_int());
+    EXPECT_TRUE(eval("(map-contains? m2 'a)")->as_boolean());
+    EXPECT_EQ("((b . 2))", eval("(map->alist m3)")->to_string());
+}
+
+TEST_F(SchemePersistentTest, ManyKeys)
+{
+    perform("(define (fill m i n) (if (= i n) m (fill (map-assoc m i (* i i)) (+ i 1) n)))");
+    perform("(define (drain m i n) (if (= i n) m (drain (map-dissoc m i) (+ i 2) n)))");
+    perform("(define full (fill (persistent-map) 0 5000))");
+    perform("(define half (drain full 0 5000))");
+    EXPECT_EQ(integer(5000), eval("(map-count full)")->as_number_int());
+    EXPECT_EQ(integer(2500), eval("(map-count half)")->as_number_int());
+    EXPECT_EQ(integer(4999 * 4999), eval("(map-ref half 4999)")->as_number_int());
+    EXPECT_EQ(integer(1764), eval("(map-ref full 42)")->as_number_int());
+    EXPECT_FALSE(eval("(map-contains? half 42)")->as_boolean());
+    EXPECT_EQ(integer(0), eval("(map-count (drain half 1 5001))")->as_number_int());
+}
+
+TEST_F(SchemePersistentTest, SetOperations)
+{
+    perform("(define s (persistent-set 1 2 '(3 4)))");
+    EXPECT_TRUE(eval("(set? s)")->as_boolean());
+    EXPECT_TRUE(eval("(set-contains? s (list 3 4))")->as_boolean());
+    EXPECT_FALSE(eval("(set-contains? s 5)")->as_boolean());
+    EXPECT_EQ(integer(3), eval("(set-count (set-add s 1 2))")->as_number_int());
+    EXPECT_EQ(integer(4), eval("(set-count (set-add s 5))")->as_number_int());
+    EXPECT_EQ(integer(3), eval("(set-count s)")->as_number_int());
+    EXPECT_EQ("(2)", eval("(set->list (set-remove s 1 '(3 4)))")->to_string());
+    EXPECT_EQ(integer(2), eval("(set-count (list->set '(a b a)))")->as_number_int());
+    EXPECT_THROW(eval("(set-add (persistent-map) 1)"), GlomError);
+    EXPECT_THROW(eval("(list->set '(a b . c))"), GlomError);
+}
+
+TEST_F(SchemePersistentTest, Equality)
+{
+    EXPECT_TRUE(eval("(equal? (persistent-map 'a 1 'b 2) (persistent-map 'b 2 'a 1))")->as_boolean());
+    EXPECT_FALSE(eval("(equal? (persistent-map 'a 1) (persistent-map 'a 2))")->as_boolean());
+    EXPECT_TRUE(eval("(equal? (persistent-set 1 2) (set-remove (persistent-set 2 3 1) 3))")->as_boolean());
+    EXPECT_FALSE(eval("(equal? (persistent-set 1) (persistent-map 1 1))")->as_boolean());
+    perform("(define t (make-hash-table equal?))");
+    perform("(hash-table-set! t (persistent-set 'x 'y) 'found)");
+    EXPECT_EQ("found", eval("(hash-table-ref t (persistent-set 'y 'x))")->to_string());
+}
@@ -196,6 +196,12 @@ TEST_F(SchemePrimitivesTest, EqualStructure)
     EXPECT_EQ(Expr::TRUE, eval("(equal? '(1 2 3) '(1 2 3))"));
     EXPECT_EQ(Expr::TRUE, eval("(equal? \"hello\" \"hello\")"));
     EXPECT_EQ(Expr::FALSE, eval("(equal? '(1 2 3) '(1 2))"));
+    EXPECT_EQ(Expr::TRUE, eval("(equal? '(1 (2 . 3) . 4) '(1 (2 . 3) . 4))"));
+    EXPECT_EQ(Expr::FALSE, eval("(equal? '(1 2 . 3) '(1 2 3))"));
+    EXPECT_EQ(Expr::FALSE, eval("(equal? '(1 2) '(1 2 . 3))"));
+    EXPECT_EQ(Expr::TRUE, eval("(equal? '() '())"));
+    perform("(define (build n acc) (if (= n 0) acc (build (- n 1) (cons n acc))))");
+    EXPECT_EQ(Expr::TRUE, eval("(equal? (build 3000 '()) (build 3000 '()))"));
 }
 
 // Condition tests
@@ -0,0 +1,115 @@
+//
+// Created by glom on 11/7/25.
+//
+#include <gtest/gtest.h>
+#include <vector>
+#include <memory>
+
+#include "expr.h"
+#include "context.h"
+#include "parser.h"
+#include "eval.h"
+#include "error.h"
+
+class SchemePVectorTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        context = make_root_context();
+    }
+
+    void TearDown() override
+    {
+        context.reset();
+    }
+
+    [[nodiscard]] shared_ptr<Expr> eval(const std::string& input) const
+    {
+        const auto exprs = parse(input);
+        return ::eval(context, exprs);
+    }
+
+    void perform(const std::string& input) const
+    {
+        const auto exprs = parse(input);
+        ::eval(context, exprs);
+    }
+
+    static shared_ptr<Expr> parse_and_get_first(const std::string& input)
+    {
+        const auto exprs = parse(input);
+        if (exprs->empty()) return Expr::NOTHING;
+        return exprs->car();
+    }
+
+    std::shared_ptr<Context> context;
+};
+
+
+TEST_F(SchemePVectorTest, BasicOperations)
+{
+    perform("(define v (pvector 1 \"two\" '(3)))");
+    EXPECT_TRUE(eval("(pvector? v)")->as_boolean());
+    EXPECT_FALSE(eval("(pvector? (vector 1 2))")->as_boolean());
+    EXPECT_EQ(integer(3), eval("(pvector-length v)")->as_number_int());
+    EXPECT_EQ("two", eval("(pvector-ref v 1)")->as_string());
+    EXPECT_EQ("#pvector(1 two (3))", eval("v")->to_string());
+    EXPECT_EQ("#pvector(1 x (3))", eval("(pvector-set v 1 'x)")->to_string());
+    EXPECT_EQ("two", eval("(pvector-ref v 1)")->as_string());
+    EXPECT_EQ("(1 two (3) 4 5)", eval("(pvector->list (pvector-push v 4 5))")->to_string());
+    EXPECT_EQ(integer(3), eval("(pvector-length v)")->as_number_int());
+    EXPECT_EQ("#pvector(a b)", eval("(list->pvector '(a b))")->to_string());
+    EXPECT_EQ("#pvector()", eval("(pvector)")->to_string());
+    EXPECT_THROW(eval("(pvector-ref v 3)"), GlomError);
+    EXPECT_THROW(eval("(pvector-set v -1 0)"), GlomError);
+    EXPECT_THROW(eval("(pvector-length '(1))"), GlomError);
+    EXPECT_THROW(eval("(list->pvector '(a b . c))"), GlomError);
+}
+
+TEST_F(SchemePVectorTest, Push)
+{
+    perform("(define (fill v i n) (if (= i n) v (fill (pvector-push v (* i 3)) (+ i 1) n)))");
+    perform("(define v (fill (pvector) 0 5000))");
+    perform("(define (check v i n) (if (= i n) #t (if (= (pvector-ref v i) (* i 3)) (check v (+ i 1) n) i)))");
+    EXPECT_EQ(integer(5000), eval("(pvector-length v)")->as_number_int());
+    EXPECT_TRUE(eval("(check v 0 5000)")->as_boolean());
+    EXPECT_EQ(integer(-1), eval("(pvector-ref (pvector-set v 4000 -1) 4000)")->as_number_int());
+    EXPECT_EQ(integer(12000), eval("(pvector-ref v 4000)")->as_number_int());
+}
+
+TEST_F(SchemePVectorTest, AppendAndSlice)
+{
+    perform("(define (range a b) (if (>= a b) '() (cons a (range (+ a 1) b))))");
+    // Uneven pieces leave relaxed nodes on every seam
+    perform("(define (build v i n) (if (>= i n) v"
+            " (build (pvector-append v (list->pvector (range i (min n (+ i 1 (modulo (* i 7) 45))))))"
+            " (+ i 1 (modulo (* i 7) 45)) n)))");
+    perform("(define v (build (pvector) 0 3000))");
+    perform("(define (check v i n offset) (if (= i n) #t"
+            " (if (= (pvector-ref v i) (+ i offset)) (check v (+ i 1) n offset) i)))");
+    EXPECT_EQ(integer(3000), eval("(pvector-length v)")->as_number_int());
+    EXPECT_TRUE(eval("(check v 0 3000 0)")->as_boolean());
+    perform("(define doubled (pvector-append v v))");
+    EXPECT_EQ(integer(6000), eval("(pvector-length doubled)")->as_number_int());
+    EXPECT_EQ(integer(2999), eval("(pvector-ref doubled 5999)")->as_number_int());
+    EXPECT_EQ(integer(0), eval("(pvector-ref doubled 3000)")->as_number_int());
+    perform("(define middle (pvector-slice v 1234 2901))");
+    EXPECT_EQ(integer(1667), eval("(pvector-length middle)")->as_number_int());
+    EXPECT_TRUE(eval("(check middle 0 1667 1234)")->as_boolean());
+    perform("(define joined (pvector-append (pvector-slice v 0 1234) middle (pvector-slice v 2901)))");
+    EXPECT_TRUE(eval("(equal? joined v)")->as_boolean());
+    EXPECT_EQ(integer(0), eval("(pvector-length (pvector-slice v 3000))")->as_number_int());
+    EXPECT_THROW(eval("(pvector-slice v 10 5)"), GlomError);
+    EXPECT_THROW(eval("(pvector-slice v 0 3001)"), GlomError);
+}
+
+TEST_F(SchemePVectorTest, Equality)
+{
+    EXPECT_TRUE(eval("(equal? (pvector 1 '(2)) (pvector-push (pvector 1) (list 2)))")->as_boolean());
+    EXPECT_FALSE(eval("(equal? (pvector 1 2) (pvector 1 2 3))")->as_boolean());
+    EXPECT_FALSE(eval("(equal? (pvector 1 2) (vector 1 2))")->as_boolean());
+    perform("(define t (make-hash-table equal?))");
+    perform("(hash-table-set! t (pvector 'a 'b) 'found)");
+    EXPECT_EQ("found", eval("(hash-table-ref t (pvector-append (pvector 'a) (pvector 'b)))")->to_string());
+}
@@ -0,0 +1,107 @@
+//
+// Created by glom on 11/11/25.
+//
+#include <gtest/gtest.h>
+#include <vector>
+#include <memory>
+
+#include "expr.h"
+#include "context.h"
+#include "parser.h"
+#include "eval.h"
+#include "error.h"
+
+class SchemeRecordTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        context = make_root_context();
+    }
+
+    void TearDown() override
+    {
+        context.reset();
+    }
+
+    [[nodiscard]] shared_ptr<Expr> eval(const std::string& input) const
+    {
+        const auto exprs = parse(input);
+        return ::eval(context, exprs);
+    }
+
+    void perform(const std::string& input) const
+    {
+        const auto exprs = parse(input);
+        ::eval(context, exprs);
+    }
+
+    static shared_ptr<Expr> parse_and_get_first(const std::string& input)
+    {
+        const auto exprs = parse(input);
+        if (exprs->empty()) return Expr::NOTHING;
+        return exprs->car();
+    }
+
+    std::shared_ptr<Context> context;
+};
+
+
+TEST_F(SchemeRecordTest, ConstructorAndAccessors)
+{
+    perform("(define-record-type <point> (make-point x y) point? (x point-x set-point-x!) (y point-y))");
+    perform("(define p (make-point 1 2))");
+    EXPECT_EQ(integer(1), eval("(point-x p)")->as_number_int());
+    EXPECT_EQ(integer(2), eval("(point-y p)")->as_number_int());
+    perform("(set-point-x! p 10)");
+    EXPECT_EQ(integer(10), eval("(point-x p)")->as_number_int());
+    EXPECT_EQ("#<<point> x: 10 y: 2>", eval("p")->to_string());
+    EXPECT_EQ("#<record-type <point>>", eval("<point>")->to_string());
+}
+
+TEST_F(SchemeRecordTest, Predicate)
+{
+    perform("(define-record-type <point> (make-point x y) point? (x point-x) (y point-y))");
+    perform("(define-record-type <size> (make-size x y) size? (x size-x) (y size-y))");
+    EXPECT_TRUE(eval("(point? (make-point 1 2))")->as_boolean());
+    EXPECT_FALSE(eval("(point? (make-size 1 2))")->as_boolean());
+    EXPECT_FALSE(eval("(point? '(1 2))")->as_boolean());
+    EXPECT_FALSE(eval("(point? 5)")->as_boolean());
+    // Accessors only accept records of their own type
+    EXPECT_THROW(eval("(point-x (make-size 1 2))"), GlomError);
+    EXPECT_THROW(eval("(point-x 5)"), GlomError);
+}
+
+TEST_F(SchemeRecordTest, ConstructorFieldOrder)
+{
+    perform("(define-record-type node (make-node value) node? (next node-next set-node-next!) (value node-value))");
+    perform("(define n (make-node 7))");
+    EXPECT_EQ(integer(7), eval("(node-value n)")->as_number_int());
+    perform("(set-node-next! n (make-node 8))");
+    EXPECT_EQ(integer(8), eval("(node-value (node-next n))")->as_number_int());
+    EXPECT_THROW(eval("(make-node 1 2)"), GlomError);
+    EXPECT_THROW(eval("(make-node)"), GlomError);
+}
+
+TEST_F(SchemeRecordTest, Identity)
+{
+    perform("(define-record-type <point> (make-point x y) point? (x point-x) (y point-y))");
+    perform("(define p (make-point 1 2))");
+    EXPECT_TRUE(eval("(eq? p p)")->as_boolean());
+    EXPECT_TRUE(eval("(equal? p p)")->as_boolean());
+    EXPECT_FALSE(eval("(eqv? p (make-point 1 2))")->as_boolean());
+    // Records work as procedure values and hash table keys
+    EXPECT_EQ("(1 3)", eval("(map point-x (list p (make-point 3 4)))")->to_string());
+    perform("(define table (make-hash-table))");
+    perform("(hash-table-set! table p 'found)");
+    EXPECT_EQ("found", eval("(hash-table-ref/default table p #f)")->to_string());
+}
+
+TEST_F(SchemeRecordTest, InvalidDefinitions)
+{
+    EXPECT_THROW(perform("(define-record-type <p> (make-p z) p? (x p-x))"), GlomError);
+    EXPECT_THROW(perform("(define-record-type <p> (make-p x) p? (x p-x) (x p-x2))"), GlomError);
+    EXPECT_THROW(perform("(define-record-type <p> make-p p? (x p-x))"), GlomError);
+    EXPECT_THROW(perform("(define-record-type <p> (make-p x) p? (x))"), GlomError);
+    EXPECT_THROW(perform("(define-record-type <p> (make-p x))"), GlomError);
+}
@@ -2,12 +2,15 @@
 // Created by glom on 10/1/25.
 //
 #include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
 #include <memory>
 
 #include "expr.h"
 #include "context.h"
 #include "parser.h"
 #include "eval.h"
+#include "error.h"
 
 class SchemeTypesTest : public ::testing::Test
 {
@@ -140,6 +143,25 @@ TEST_F(SchemeTypesTest, ExactToInexact)
     EXPECT_NEAR(3.14, eval("(exact->inexact 3.14)")->as_number_real(), 0.001); // already inexact
 }
 
+TEST_F(SchemeTypesTest, ExactToInexactRounding)
+{
+    const auto digits = std::to_string(std::numeric_limits<real>::digits);
+    EXPECT_EQ(real(1) / real(3), eval("(exact->inexact 1/3)")->as_number_real());
+    EXPECT_EQ(-real(2) / real(7), eval("(exact->inexact -2/7)")->as_number_real());
+    EXPECT_EQ(std::ldexp(real(1), 1000), eval("(exact->inexact (expt 2 1000))")->as_number_real());
+    // Both parts overflow a real on their own, their quotient does not
+    EXPECT_EQ(real(10), eval("(exact->inexact (/ (expt 10 400) (+ (expt 10 399) 1)))")->as_number_real());
+    EXPECT_EQ(std::ldexp(real(1), -2000), eval("(exact->inexact (/ 1 (expt 2 2000)))")->as_number_real());
+    EXPECT_TRUE(std::isinf(eval("(exact->inexact (expt 10 5000))")->as_number_real()));
+    // Ties round to even, anything past the tie rounds up
+    const auto two_p = std::ldexp(real(1), std::numeric_limits<real>::digits);
+    EXPECT_EQ(two_p, eval("(exact->inexact (+ (expt 2 " + digits + ") 1))")->as_number_real());
+    EXPECT_EQ(two_p + 4, eval("(exact->inexact (+ (expt 2 " + digits + ") 3))")->as_number_real());
+    EXPECT_EQ(std::ldexp(two_p + 2, 100),
+              eval("(exact->inexact (+ (expt 2 (+ " + digits + " 100)) (expt 2 100) 1))")->as_number_real());
+    EXPECT_EQ(two_p / 3, eval("(exact->inexact (/ (expt 2 " + digits + ") 3))")->as_number_real());
+}
+
 // inexact->exact conversion tests
 TEST_F(SchemeTypesTest, InexactToExact)
 {
@@ -160,6 +182,10 @@ TEST_F(SchemeTypesTest, NumberToString)
     // Test float conversion
     const auto result2 = eval("(number->string 3.14)");
     EXPECT_TRUE(result2->is_string());
+    EXPECT_EQ("3.14", result2->as_string());
+    EXPECT_EQ("2.0", eval("(number->string 2.0)")->as_string());
+    EXPECT_EQ("-0.5", eval("(number->string -0.5)")->as_string());
+    EXPECT_EQ("+inf.0", eval("(number->string (/ 1.0 0.0))")->as_string());
 
     // Test negative number
     const auto result3 = eval("(number->string -42)");
@@ -175,6 +201,8 @@ TEST_F(SchemeTypesTest, StringToNumber)
 
     // Test float conversion
     EXPECT_NEAR(3.14, eval("(string->number \"3.14\")")->as_number_real(), 0.001);
+    // Printing is shortest round-trip, so reading the text back yields the same value
+    EXPECT_EQ(eval("(/ 1.0 3.0)")->as_number_real(), eval("(string->number (number->string (/ 1.0 3.0)))")->as_number_real());
 
     // Test negative number
     EXPECT_EQ(integer(-42), eval("(string->number \"-42\")")->as_number_int());
@@ -184,6 +212,37 @@ TEST_F(SchemeTypesTest, StringToNumber)
     EXPECT_EQ(Expr::FALSE, eval("(string->number \"12a3\")"));
 }
 
+TEST_F(SchemeTypesTest, NumberRadix)
+{
+    EXPECT_EQ("ff", eval("(number->string 255 16)")->as_string());
+    EXPECT_EQ("-101", eval("(number->string -5 2)")->as_string());
+    EXPECT_EQ("17/10", eval("(number->string 15/8 8)")->as_string());
+    EXPECT_EQ("1" + std::string(50, '0'), eval("(number->string (expt 2 150) 8)")->as_string());
+    EXPECT_EQ("-1" + std::string(40, '0') + "1", eval("(number->string (- -1 (expt 16 41)) 16)")->as_string());
+    EXPECT_EQ("123456789012345678901234567890", eval("(number->string 123456789012345678901234567890 10)")->as_string());
+
+    EXPECT_EQ(integer(255), eval("(string->number \"ff\" 16)")->as_number_int());
+    EXPECT_EQ(integer(255), eval("(string->number \"#xFF\")")->as_number_int());
+    EXPECT_EQ(integer(-5), eval("(string->number \"-101\" 2)")->as_number_int());
+    EXPECT_EQ(integer(8), eval("(string->number \"#o10\" 16)")->as_number_int());
+    EXPECT_EQ(rational(integer(3), integer(4)), eval("(string->number \"6/8\")")->as_number_rat());
+    EXPECT_EQ(rational(integer(1), integer(2)), eval("(string->number \"#b1/10\")")->as_number_rat());
+    EXPECT_EQ(eval("(expt 2 200)")->to_string(), eval("(string->number (number->string (expt 2 200) 16) 16)")->to_string());
+    EXPECT_EQ(eval("(- (expt 3 100))")->to_string(), eval("(string->number (number->string (- (expt 3 100)) 2) 2)")->to_string());
+    EXPECT_EQ(real(1000), eval("(string->number \"1e3\")")->as_number_real());
+    EXPECT_TRUE(std::isinf(eval("(string->number \"-inf.0\")")->as_number_real()));
+
+    EXPECT_EQ(Expr::FALSE, eval("(string->number \"12\" 2)"));
+    EXPECT_EQ(Expr::FALSE, eval("(string->number \"1/0\")"));
+    EXPECT_EQ(Expr::FALSE, eval("(string->number \"1/-2\")"));
+    EXPECT_EQ(Expr::FALSE, eval("(string->number \"inf\")"));
+    EXPECT_EQ(Expr::FALSE, eval("(string->number \"1.5\" 16)"));
+    EXPECT_EQ(Expr::FALSE, eval("(string->number \"\")"));
+    EXPECT_EQ(Expr::FALSE, eval("(string->number \"-\")"));
+    EXPECT_THROW(eval("(number->string 1.5 2)"), GlomError);
+    EXPECT_THROW(eval("(number->string 10 3)"), GlomError);
+}
+
 // symbol->string
 TEST_F(SchemeTypesTest, SymbolToString)
 {
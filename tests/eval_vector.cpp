@@ -0,0 +1,116 @@
+//
+// Created by glom on 11/6/25.
+//
+#include <gtest/gtest.h>
+#include <vector>
+#include <memory>
+
+#include "expr.h"
+#include "context.h"
+#include "parser.h"
+#include "eval.h"
+#include "error.h"
+
+class SchemeVectorTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        context = make_root_context();
+    }
+
+    void TearDown() override
+    {
+        context.reset();
+    }
+
+    [[nodiscard]] shared_ptr<Expr> eval(const std::string& input) const
+    {
+        const auto exprs = parse(input);
+        return ::eval(context, exprs);
+    }
+
+    void perform(const std::string& input) const
+    {
+        const auto exprs = parse(input);
+        ::eval(context, exprs);
+    }
+
+    static shared_ptr<Expr> parse_and_get_first(const std::string& input)
+    {
+        const auto exprs = parse(input);
+        if (exprs->empty()) return Expr::NOTHING;
+        return exprs->car();
+    }
+
+    std::shared_ptr<Context> context;
+};
+
+
+TEST_F(SchemeVectorTest, Construction)
+{
+    EXPECT_EQ("#(1 2 3)", eval("(vector 1 (+ 1 1) 3)")->to_string());
+    EXPECT_EQ("#(x x)", eval("(make-vector 2 'x)")->to_string());
+    EXPECT_EQ("#(0 0 0)", eval("(make-vector 3)")->to_string());
+    EXPECT_EQ("#()", eval("(vector)")->to_string());
+    EXPECT_EQ(integer(3), eval("(vector-length #(a (b c) \"d\"))")->as_number_int());
+    EXPECT_TRUE(eval("(vector? #(1))")->as_boolean());
+    EXPECT_FALSE(eval("(vector? '(1))")->as_boolean());
+    EXPECT_FALSE(eval("(vector? (f64vector 1))")->as_boolean());
+}
+
+TEST_F(SchemeVectorTest, LiteralsAreSelfEvaluating)
+{
+    EXPECT_EQ("#(a (+ 1 2))", eval("#(a (+ 1 2))")->to_string());
+    EXPECT_EQ("#(a b)", eval("'#(a b)")->to_string());
+    EXPECT_EQ("(1 #(2 3))", eval("'(1 #(2 3))")->to_string());
+    EXPECT_EQ("#(1 2)", eval("#(1 2)")->to_string());
+}
+
+TEST_F(SchemeVectorTest, AccessAndMutation)
+{
+    perform("(define v (make-vector 3 0))");
+    perform("(vector-set! v 1 'mid)");
+    EXPECT_EQ("mid", eval("(vector-ref v 1)")->to_string());
+    EXPECT_EQ("(0 mid 0)", eval("(vector->list v)")->to_string());
+    perform("(define w v)");
+    perform("(vector-fill! w 7)");
+    EXPECT_EQ("#(7 7 7)", eval("v")->to_string());
+    EXPECT_EQ("#(1 (2) 3)", eval("(list->vector '(1 (2) 3))")->to_string());
+    EXPECT_EQ("()", eval("(vector->list #())")->to_string());
+    EXPECT_THROW(eval("(vector-ref v 3)"), GlomError);
+    EXPECT_THROW(eval("(vector-ref v -1)"), GlomError);
+    EXPECT_THROW(eval("(vector-ref '(1 2) 0)"), GlomError);
+    EXPECT_THROW(eval("(vector-set! v 0)"), GlomError);
+    EXPECT_THROW(eval("(make-vector -1)"), GlomError);
+    EXPECT_THROW(eval("(list->vector '(1 2 . 3))"), GlomError);
+}
+
+TEST_F(SchemeVectorTest, IndexedLookupIsConstantTime)
+{
+    // A table walk that would be quadratic through list-ref
+    perform("(define table (make-vector 20000 1))");
+    perform("(define (sum i acc) (if (= i 20000) acc (sum (+ i 1) (+ acc (vector-ref table i)))))");
+    EXPECT_EQ(integer(20000), eval("(sum 0 0)")->as_number_int());
+}
+
+TEST_F(SchemeVectorTest, Equality)
+{
+    EXPECT_TRUE(eval("(equal? #(1 (2 \"x\") #(3)) (vector 1 (list 2 \"x\") (vector 3)))")->as_boolean());
+    EXPECT_FALSE(eval("(equal? #(1 2) #(1 2 3))")->as_boolean());
+    EXPECT_FALSE(eval("(equal? #(1 2) '(1 2))")->as_boolean());
+    EXPECT_FALSE(eval("(eq? (vector 1) (vector 1))")->as_boolean());
+    perform("(define v (vector 1))");
+    EXPECT_TRUE(eval("(eq? v v)")->as_boolean());
+    // Shared substructure is equal to distinct copies of it
+    perform("(define w (vector 1 2))");
+    EXPECT_TRUE(eval("(equal? (vector w w) (vector (vector 1 2) (vector 1 2)))")->as_boolean());
+    EXPECT_TRUE(eval("(equal? (vector (vector 1 2) (vector 1 2)) (vector w w))")->as_boolean());
+    EXPECT_FALSE(eval("(equal? (vector w w) (vector (vector 1 2) (vector 1 3)))")->as_boolean());
+    perform("(define p (list 1 2))");
+    EXPECT_TRUE(eval("(equal? (vector p p) (vector (list 1 2) (list 1 2)))")->as_boolean());
+    // and such vectors work as equal? hash table keys
+    perform("(define t (make-hash-table equal?))");
+    perform("(hash-table-set! t (vector w w) 'found)");
+    EXPECT_EQ("found", eval("(hash-table-ref/default t (vector (vector 1 2) (vector 1 2)) #f)")->to_string());
+}
@@ -0,0 +1,114 @@
+//
+// Created by glom on 11/4/25.
+//
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "limb_kernels.h"
+
+class LimbKernelsTest : public ::testing::Test
+{
+protected:
+    std::mt19937_64 random{20251104};
+
+    // Random limbs, with runs of all-ones and zeros mixed in to drive long carry chains
+    std::vector<uint64_t> limbs(const size_t n)
+    {
+        std::vector<uint64_t> result(n);
+        for (auto& limb : result)
+        {
+            switch (random() % 4)
+            {
+            case 0: limb = ~uint64_t{0}; break;
+            case 1: limb = 0; break;
+            default: limb = random(); break;
+            }
+        }
+        return result;
+    }
+
+    std::vector<uint64_t> multipliers()
+    {
+        return {0, 1, 2, ~uint64_t{0}, ~uint64_t{0} - 1, uint64_t{1} << 63, random(), random()};
+    }
+};
+
+// The dispatched kernels use the BMI2/ADX asm on capable CPUs: they must match the portable reference
+TEST_F(LimbKernelsTest, AddMulMatchesPortable)
+{
+    for (size_t n = 0; n <= 70; ++n)
+    {
+        const auto a = limbs(n);
+        const auto r = limbs(n);
+        for (const uint64_t b : multipliers())
+        {
+            auto expected = r;
+            auto actual = r;
+            const uint64_t expected_carry = limb_kernels::portable::addmul_1(expected.data(), a.data(), n, b);
+            const uint64_t actual_carry = limb_kernels::addmul_1(actual.data(), a.data(), n, b);
+            EXPECT_EQ(expected, actual) << "n = " << n << ", b = " << b << ", adx = " << limb_kernels::has_adx();
+            EXPECT_EQ(expected_carry, actual_carry) << "n = " << n << ", b = " << b;
+        }
+    }
+}
+
+TEST_F(LimbKernelsTest, SubMulMatchesPortable)
+{
+    for (size_t n = 0; n <= 70; ++n)
+    {
+        const auto a = limbs(n);
+        const auto r = limbs(n);
+        for (const uint64_t b : multipliers())
+        {
+            auto expected = r;
+            auto actual = r;
+            const uint64_t expected_borrow = limb_kernels::portable::submul_1(expected.data(), a.data(), n, b);
+            const uint64_t actual_borrow = limb_kernels::submul_1(actual.data(), a.data(), n, b);
+            EXPECT_EQ(expected, actual) << "n = " << n << ", b = " << b << ", adx = " << limb_kernels::has_adx();
+            EXPECT_EQ(expected_borrow, actual_borrow) << "n = " << n << ", b = " << b;
+        }
+    }
+}
+
+TEST_F(LimbKernelsTest, AddSubMatchPortable)
+{
+    for (size_t n = 0; n <= 70; ++n)
+    {
+        const auto a = limbs(n);
+        const auto b = limbs(n);
+        std::vector<uint64_t> expected(n);
+        std::vector<uint64_t> actual(n);
+
+        EXPECT_EQ(limb_kernels::portable::add_n(expected.data(), a.data(), b.data(), n),
+                  limb_kernels::add_n(actual.data(), a.data(), b.data(), n));
+        EXPECT_EQ(expected, actual) << "n = " << n;
+
+        EXPECT_EQ(limb_kernels::portable::sub_n(expected.data(), a.data(), b.data(), n),
+                  limb_kernels::sub_n(actual.data(), a.data(), b.data(), n));
+        EXPECT_EQ(expected, actual) << "n = " << n;
+    }
+}
+
+TEST_F(LimbKernelsTest, InPlaceAliasing)
+{
+    // The output may alias the first input
+    const auto a = limbs(33);
+    const auto b = limbs(33);
+    std::vector<uint64_t> expected(33);
+    const uint64_t carry = limb_kernels::portable::add_n(expected.data(), a.data(), b.data(), 33);
+    auto in_place = a;
+    EXPECT_EQ(carry, limb_kernels::add_n(in_place.data(), in_place.data(), b.data(), 33));
+    EXPECT_EQ(expected, in_place);
+
+    // (B^n - 1) + (B^n - 1) * (B - 1) = B^(n+1) - B: every limb carries
+    const std::vector<uint64_t> ones(8, ~uint64_t{0});
+    auto r = ones;
+    EXPECT_EQ(~uint64_t{0}, limb_kernels::addmul_1(r.data(), ones.data(), 8, ~uint64_t{0}));
+    std::vector<uint64_t> shifted(8, ~uint64_t{0});
+    shifted[0] = 0;
+    EXPECT_EQ(shifted, r);
+    EXPECT_EQ(~uint64_t{0}, limb_kernels::submul_1(r.data(), ones.data(), 8, ~uint64_t{0}));
+    EXPECT_EQ(ones, r);
+}
@@ -136,6 +136,19 @@ TEST_F(ParserTest, NestedList)
     EXPECT_EQ(2, sublist1->cdr()->as_pair()->car()->as_number_int().as_int64());
 }
 
+TEST_F(ParserTest, VectorParsing)
+{
+    const auto exprs = parse("#(1 (2 3) #())");
+    const shared_ptr<Expr> vector = std::move(exprs->car());
+    EXPECT_EQ(VECTOR, vector->get_type());
+    const auto& elements = *vector->as_vector();
+    ASSERT_EQ(3u, elements.size());
+    EXPECT_EQ(1, elements[0]->as_number_int().as_int64());
+    EXPECT_EQ(PAIR, elements[1]->get_type());
+    EXPECT_TRUE(elements[2]->as_vector()->empty());
+    EXPECT_THROW(parse("#(1 2"), std::runtime_error);
+}
+
 TEST_F(ParserTest, ErrorHandling)
 {
     EXPECT_THROW(parse("("), std::runtime_error);
@@ -76,10 +76,10 @@ TEST_F(TokenizerTest, NumberRealParsing)
     EXPECT_EQ(token.as_number_real(), from_string("4187189471398748913748931748913748913748913748913748913748931748931758975891759.0"));
     token = tokenizer.next();
     EXPECT_EQ(token.get_type(), TOKEN_NUMBER_REAL);
-    EXPECT_EQ(token.as_number_real(), 312789123789e1000L);
+    EXPECT_EQ(token.as_number_real(), static_cast<real>(312789123789e1000L));
     token = tokenizer.next();
     EXPECT_EQ(token.get_type(), TOKEN_NUMBER_REAL);
-    EXPECT_EQ(token.as_number_real(), 1212312e-1200L);
+    EXPECT_EQ(token.as_number_real(), static_cast<real>(1212312e-1200L));
 }
 
 TEST_F(TokenizerTest, StringParsing)
@@ -160,6 +160,23 @@ TEST_F(TokenizerTest, Parentheses)
     EXPECT_EQ(tokenizer.next().get_type(), TOKEN_RPAREN);
 }
 
+TEST_F(TokenizerTest, VectorParentheses)
+{
+    // A leading '#' only starts a header line for #lang and #!
+    Tokenizer tokenizer("#(1 #(a))");
+
+    EXPECT_EQ(tokenizer.next().get_type(), TOKEN_VECTOR_LPAREN);
+    EXPECT_EQ(tokenizer.next().get_type(), TOKEN_NUMBER_INT);
+    EXPECT_EQ(tokenizer.next().get_type(), TOKEN_VECTOR_LPAREN);
+    EXPECT_EQ(tokenizer.next().get_type(), TOKEN_SYMBOL);
+    EXPECT_EQ(tokenizer.next().get_type(), TOKEN_RPAREN);
+    EXPECT_EQ(tokenizer.next().get_type(), TOKEN_RPAREN);
+    EXPECT_EQ(tokenizer.next().get_type(), TOKEN_EOI);
+
+    Tokenizer header("#lang racket\n#(1)");
+    EXPECT_EQ(header.next().get_type(), TOKEN_VECTOR_LPAREN);
+}
+
 TEST_F(TokenizerTest, SkipWhitespace)
 {
     Tokenizer tokenizer("  123  \n  \"abc\"  \t  true  ");